@@ -0,0 +1,46 @@
+#pragma once
+
+#include <uacpi/types.h>
+#include <uacpi/platform/config.h>
+
+/*
+ * A simple bump allocator for short-lived allocations that belong to a single
+ * owner, e.g. an AML execution context. Memory is carved out of chunks of
+ * UACPI_EXECUTION_ARENA_CHUNK_SIZE bytes and is only returned to the host once
+ * the arena is reset or deinitialized.
+ *
+ * Freeing the most recent allocation rewinds the bump pointer, while anything
+ * else is put on a free list and handed out again to an allocation of the
+ * exact same size. This keeps the footprint bounded for the typical
+ * grow/shrink patterns of a method call stack.
+ *
+ * None of the allocations are allowed to outlive the arena, so it must only
+ * ever be used for storage that is fully owned by the arena owner.
+ */
+struct uacpi_arena_chunk;
+struct uacpi_arena_free_block;
+
+struct uacpi_arena {
+    struct uacpi_arena_chunk *chunks;
+    struct uacpi_arena_free_block *free_blocks;
+};
+
+void *uacpi_arena_alloc(struct uacpi_arena *arena, uacpi_size size);
+void uacpi_arena_free(struct uacpi_arena *arena, void *ptr, uacpi_size size);
+
+/*
+ * Resize an allocation, growing it in place if it happens to be the most
+ * recent one. Contents up to MIN(old_size, new_size) are preserved.
+ */
+void *uacpi_arena_realloc(
+    struct uacpi_arena *arena, void *ptr, uacpi_size old_size,
+    uacpi_size new_size
+);
+
+/*
+ * Invalidate all allocations at once, keeping at most one chunk around so
+ * that the next user of the arena doesn't have to go to the host right away.
+ */
+void uacpi_arena_reset(struct uacpi_arena *arena);
+
+void uacpi_arena_deinit(struct uacpi_arena *arena);
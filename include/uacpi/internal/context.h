@@ -6,6 +6,7 @@
 #include <uacpi/internal/dynamic_array.h>
 #include <uacpi/internal/shareable.h>
 #include <uacpi/context.h>
+#include <uacpi/platform/atomic.h>
 
 struct uacpi_runtime_context {
     /*
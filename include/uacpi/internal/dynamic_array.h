@@ -3,6 +3,7 @@
 #include <uacpi/types.h>
 #include <uacpi/internal/stdlib.h>
 #include <uacpi/kernel_api.h>
+#include <uacpi/internal/arena.h>
 
 #define DYNAMIC_ARRAY_WITH_INLINE_STORAGE(name, type, inline_capacity)       \
     struct name {                                                            \
@@ -24,7 +25,7 @@
     prefix type *name##_last(struct name *arr)                        \
     prefix void name##_clear(struct name *arr);
 
-#define DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(name, type, prefix)           \
+#define DYNAMIC_ARRAY_WITH_INLINE_STORAGE_COMMON_IMPL(name, type, prefix)    \
     UACPI_MAYBE_UNUSED                                                       \
     prefix uacpi_size name##_inline_capacity(struct name *arr)               \
     {                                                                        \
@@ -37,6 +38,21 @@
         return name##_inline_capacity(arr) + arr->dynamic_capacity;          \
     }                                                                        \
                                                                              \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix uacpi_size name##_next_dynamic_capacity(struct name *arr)         \
+    {                                                                        \
+        uacpi_size cap;                                                      \
+                                                                             \
+        if (arr->dynamic_capacity == 0)                                      \
+            return name##_inline_capacity(arr);                              \
+                                                                             \
+        cap = arr->dynamic_capacity / 2;                                     \
+        if (cap == 0)                                                        \
+            cap = 1;                                                         \
+                                                                             \
+        return arr->dynamic_capacity + cap;                                  \
+    }                                                                        \
+                                                                             \
     prefix type *name##_at(struct name *arr, uacpi_size idx)                 \
     {                                                                        \
         if (idx >= arr->size_including_inline)                               \
@@ -49,6 +65,30 @@
     }                                                                        \
                                                                              \
     UACPI_MAYBE_UNUSED                                                       \
+    prefix void name##_pop(struct name *arr)                                 \
+    {                                                                        \
+        if (arr->size_including_inline == 0)                                 \
+            return;                                                          \
+                                                                             \
+        arr->size_including_inline--;                                        \
+    }                                                                        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix uacpi_size name##_size(struct name *arr)                          \
+    {                                                                        \
+        return arr->size_including_inline;                                   \
+    }                                                                        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix type *name##_last(struct name *arr)                               \
+    {                                                                        \
+        return name##_at(arr, arr->size_including_inline - 1);               \
+    }
+
+#define DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(name, type, prefix)           \
+    DYNAMIC_ARRAY_WITH_INLINE_STORAGE_COMMON_IMPL(name, type, prefix)        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
     prefix type *name##_alloc(struct name *arr)                              \
     {                                                                        \
         uacpi_size inline_cap;                                               \
@@ -61,32 +101,23 @@
                                                                              \
             dynamic_size = arr->size_including_inline - inline_cap;          \
             if (dynamic_size == arr->dynamic_capacity) {                     \
-                uacpi_size bytes, type_size;                                 \
+                uacpi_size new_capacity, type_size;                          \
                 void *new_buf;                                               \
                                                                              \
                 type_size = sizeof(*arr->dynamic_storage);                   \
+                new_capacity = name##_next_dynamic_capacity(arr);            \
                                                                              \
-                if (arr->dynamic_capacity == 0) {                            \
-                    bytes = type_size * inline_cap;                          \
-                } else {                                                     \
-                    bytes = (arr->dynamic_capacity / 2) * type_size;         \
-                    if (bytes == 0)                                          \
-                        bytes += type_size;                                  \
+                new_buf = uacpi_kernel_alloc(new_capacity * type_size);      \
+                if (new_buf != UACPI_NULL && arr->dynamic_storage) {         \
+                    uacpi_size bytes = dynamic_size * type_size;             \
                                                                              \
-                    bytes += arr->dynamic_capacity * type_size;              \
+                    uacpi_memcpy(new_buf, arr->dynamic_storage, bytes);      \
+                    uacpi_free(arr->dynamic_storage, bytes);                 \
                 }                                                            \
-                                                                             \
-                new_buf = uacpi_kernel_alloc(bytes);                         \
                 if (uacpi_unlikely(new_buf == UACPI_NULL))                   \
                     return UACPI_NULL;                                       \
                                                                              \
-                arr->dynamic_capacity = bytes / type_size;                   \
-                                                                             \
-                if (arr->dynamic_storage) {                                  \
-                    uacpi_memcpy(new_buf, arr->dynamic_storage,              \
-                                 dynamic_size * type_size);                  \
-                }                                                            \
-                uacpi_free(arr->dynamic_storage, dynamic_size * type_size);  \
+                arr->dynamic_capacity = new_capacity;                        \
                 arr->dynamic_storage = new_buf;                              \
             }                                                                \
                                                                              \
@@ -114,31 +145,83 @@
         return ret;                                                          \
     }                                                                        \
                                                                              \
-    UACPI_MAYBE_UNUSED                                                       \
-    prefix void name##_pop(struct name *arr)                                 \
+    prefix void name##_clear(struct name *arr)                               \
     {                                                                        \
-        if (arr->size_including_inline == 0)                                 \
-            return;                                                          \
-                                                                             \
-        arr->size_including_inline--;                                        \
-    }                                                                        \
+        uacpi_free(                                                          \
+            arr->dynamic_storage,                                            \
+            arr->dynamic_capacity * sizeof(*arr->dynamic_storage)            \
+        );                                                                   \
+        arr->size_including_inline = 0;                                      \
+        arr->dynamic_capacity = 0;                                           \
+        arr->dynamic_storage = UACPI_NULL;                                   \
+    }
+
+/*
+ * Same as DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL, except that the dynamic
+ * storage is carved out of an arena, which must be passed to every function
+ * that might allocate or free memory (alloc, calloc & clear).
+ */
+#define DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(name, type, prefix)     \
+    DYNAMIC_ARRAY_WITH_INLINE_STORAGE_COMMON_IMPL(name, type, prefix)        \
                                                                              \
     UACPI_MAYBE_UNUSED                                                       \
-    prefix uacpi_size name##_size(struct name *arr)                          \
+    prefix type *name##_alloc(struct name *arr, struct uacpi_arena *arena)   \
     {                                                                        \
-        return arr->size_including_inline;                                   \
+        uacpi_size inline_cap;                                               \
+        type *out_ptr;                                                       \
+                                                                             \
+        inline_cap = name##_inline_capacity(arr);                            \
+                                                                             \
+        if (arr->size_including_inline >= inline_cap) {                      \
+            uacpi_size dynamic_size;                                         \
+                                                                             \
+            dynamic_size = arr->size_including_inline - inline_cap;          \
+            if (dynamic_size == arr->dynamic_capacity) {                     \
+                uacpi_size new_capacity, type_size;                          \
+                void *new_buf;                                               \
+                                                                             \
+                type_size = sizeof(*arr->dynamic_storage);                   \
+                new_capacity = name##_next_dynamic_capacity(arr);            \
+                                                                             \
+                new_buf = uacpi_arena_realloc(                               \
+                    arena, arr->dynamic_storage, dynamic_size * type_size,   \
+                    new_capacity * type_size                                 \
+                );                                                           \
+                if (uacpi_unlikely(new_buf == UACPI_NULL))                   \
+                    return UACPI_NULL;                                       \
+                                                                             \
+                arr->dynamic_capacity = new_capacity;                        \
+                arr->dynamic_storage = new_buf;                              \
+            }                                                                \
+                                                                             \
+            out_ptr = &arr->dynamic_storage[dynamic_size];                   \
+            goto ret;                                                        \
+        }                                                                    \
+                                                                             \
+                                                                             \
+        out_ptr = &arr->inline_storage[arr->size_including_inline];          \
+                                                                             \
+    ret:                                                                     \
+        arr->size_including_inline++;                                        \
+        return out_ptr;                                                      \
     }                                                                        \
                                                                              \
     UACPI_MAYBE_UNUSED                                                       \
-    prefix type *name##_last(struct name *arr)                               \
+    prefix type *name##_calloc(struct name *arr, struct uacpi_arena *arena)  \
     {                                                                        \
-        return name##_at(arr, arr->size_including_inline - 1);               \
+        type *ret;                                                           \
+                                                                             \
+        ret = name##_alloc(arr, arena);                                      \
+        if (ret)                                                             \
+            uacpi_memzero(ret, sizeof(*ret));                                \
+                                                                             \
+        return ret;                                                          \
     }                                                                        \
                                                                              \
-    prefix void name##_clear(struct name *arr)                               \
+    prefix void name##_clear(struct name *arr, struct uacpi_arena *arena)    \
     {                                                                        \
-        uacpi_free(                                                          \
-            arr->dynamic_storage,                                            \
+        uacpi_arena_free(                                                    \
+            arena, arr->dynamic_storage,                                     \
             arr->dynamic_capacity * sizeof(*arr->dynamic_storage)            \
         );                                                                   \
         arr->size_including_inline = 0;                                      \
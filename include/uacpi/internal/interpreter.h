@@ -11,6 +11,20 @@ enum uacpi_table_load_cause {
     UACPI_TABLE_LOAD_CAUSE_HOST,
 };
 
+uacpi_status uacpi_initialize_interpreter(void);
+
+/*
+ * Release execution contexts cached for reuse. Must not be called while any
+ * AML is being executed.
+ */
+void uacpi_deinitialize_interpreter(void);
+
+/*
+ * Drop all method results memoized by the eval cache, see
+ * UACPI_EVAL_CACHE_SIZE. Safe to call concurrently with AML execution.
+ */
+void uacpi_eval_cache_invalidate(void);
+
 uacpi_status uacpi_execute_table(void*, enum uacpi_table_load_cause cause);
 uacpi_status uacpi_osi(uacpi_handle handle, uacpi_object *retval);
 
@@ -18,3 +32,19 @@ uacpi_status uacpi_execute_control_method(
     uacpi_namespace_node *scope, uacpi_control_method *method,
     const uacpi_object_array *args, uacpi_object **ret
 );
+
+/*
+ * Same as uacpi_execute_control_method, but only requires the caller to hold
+ * the namespace read lock, which allows multiple methods to run concurrently.
+ *
+ * The execution is aborted right before the first operation that would modify
+ * any state visible outside of the invocation (creating named objects, storing
+ * to them, accessing operation regions, mutexes & events, Notify, Sleep etc).
+ * In that case UACPI_STATUS_DENIED is returned, no output object is produced,
+ * and the caller is expected to retry via uacpi_execute_control_method with
+ * the namespace write lock held.
+ */
+uacpi_status uacpi_execute_control_method_shared(
+    uacpi_namespace_node *scope, uacpi_control_method *method,
+    const uacpi_object_array *args, uacpi_object **ret
+);
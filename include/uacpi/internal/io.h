@@ -6,6 +6,36 @@
 
 uacpi_size uacpi_round_up_bits_to_bytes(uacpi_size bit_length);
 
+typedef uacpi_status (*uacpi_gas_read_fn)(
+    uacpi_handle, uacpi_size offset, uacpi_u8 byte_width, uacpi_u64 *value
+);
+typedef uacpi_status (*uacpi_gas_write_fn)(
+    uacpi_handle, uacpi_size offset, uacpi_u8 byte_width, uacpi_u64 value
+);
+
+struct uacpi_mapped_gas {
+    // Virtual address for SystemMemory, io handle for SystemIO
+    uacpi_handle mapping;
+    uacpi_size size;
+
+    uacpi_u8 access_bit_width;
+    uacpi_u8 total_bit_width;
+    uacpi_u8 bit_offset;
+
+    uacpi_gas_read_fn read;
+    uacpi_gas_write_fn write;
+    void (*unmap)(uacpi_handle, uacpi_size);
+};
+
+/*
+ * Same as uacpi_{map,unmap}_gas, but for a caller-provided handle, e.g. one
+ * embedded into a larger structure.
+ */
+uacpi_status uacpi_map_gas_noalloc(
+    const struct acpi_gas *gas, struct uacpi_mapped_gas *out_mapped
+);
+void uacpi_unmap_gas_nofree(struct uacpi_mapped_gas *gas);
+
 void uacpi_read_buffer_field(
     const uacpi_buffer_field *field, void *dst
 );
@@ -29,3 +59,14 @@ uacpi_status uacpi_system_io_write(
 
 uacpi_status uacpi_system_memory_read(void *ptr, uacpi_u8 width, uacpi_u64 *out);
 uacpi_status uacpi_system_memory_write(void *ptr, uacpi_u8 width, uacpi_u64 in);
+
+/*
+ * Copy 'length' bytes between 'ptr' and 'buf' using 'width'-sized accesses
+ * to 'ptr', 'length' must be a multiple of 'width'.
+ */
+uacpi_status uacpi_system_memory_read_block(
+    void *ptr, uacpi_u8 width, void *buf, uacpi_size length
+);
+uacpi_status uacpi_system_memory_write_block(
+    void *ptr, uacpi_u8 width, const void *buf, uacpi_size length
+);
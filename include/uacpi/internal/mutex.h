@@ -2,6 +2,7 @@
 
 #include <uacpi/internal/types.h>
 #include <uacpi/kernel_api.h>
+#include <uacpi/namespace.h>
 
 uacpi_bool uacpi_this_thread_owns_aml_mutex(uacpi_mutex*);
 
@@ -62,10 +63,27 @@ uacpi_status uacpi_recursive_lock_deinit(struct uacpi_recursive_lock *lock);
 uacpi_status uacpi_recursive_lock_acquire(struct uacpi_recursive_lock *lock);
 uacpi_status uacpi_recursive_lock_release(struct uacpi_recursive_lock *lock);
 
+/*
+ * A writer-preferring reader/writer lock. Readers only touch the atomic state
+ * word as long as no writer is active or waiting, anything else falls back to
+ * the kernel mutex/event objects below.
+ *
+ * Once a writer starts waiting new readers are held back, so the read lock
+ * must never be acquired recursively by the same thread.
+ */
 struct uacpi_rw_lock {
-    uacpi_handle read_mutex;
+    // Number of active readers, the top bit is set while a writer is present
+    uacpi_u32 state;
+
+    // Incremented every time a reader or a writer had to block
+    uacpi_u32 read_contentions;
+    uacpi_u32 write_contentions;
+
+    // Serializes writers & readers that got held back by a writer
     uacpi_handle write_mutex;
-    uacpi_size num_readers;
+
+    // Signaled by the last reader to leave while a writer is waiting
+    uacpi_handle readers_done_event;
 };
 
 uacpi_status uacpi_rw_lock_init(struct uacpi_rw_lock *lock);
@@ -76,3 +94,7 @@ uacpi_status uacpi_rw_unlock_read(struct uacpi_rw_lock *lock);
 
 uacpi_status uacpi_rw_lock_write(struct uacpi_rw_lock *lock);
 uacpi_status uacpi_rw_unlock_write(struct uacpi_rw_lock *lock);
+
+void uacpi_rw_lock_get_stats(
+    struct uacpi_rw_lock *lock, uacpi_rw_lock_stats *out_stats
+);
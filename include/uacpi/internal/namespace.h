@@ -4,6 +4,7 @@
 #include <uacpi/internal/shareable.h>
 #include <uacpi/status.h>
 #include <uacpi/namespace.h>
+#include <uacpi/platform/config.h>
 
 #define UACPI_NAMESPACE_NODE_FLAG_ALIAS (1 << 0)
 
@@ -32,6 +33,11 @@ typedef struct uacpi_namespace_node {
     struct uacpi_namespace_node *parent;
     struct uacpi_namespace_node *child;
     struct uacpi_namespace_node *next;
+
+#if UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD != 0
+    // Only present for nodes with a lot of children
+    struct uacpi_namespace_child_index *child_index;
+#endif
 } uacpi_namespace_node;
 
 uacpi_status uacpi_initialize_namespace(void);
@@ -75,6 +81,18 @@ uacpi_status uacpi_namespace_node_install(
 );
 uacpi_status uacpi_namespace_node_uninstall(uacpi_namespace_node *node);
 
+/*
+ * Returns a counter that is incremented on every permanent node
+ * install/uninstall, which allows callers to validate cached lookup results.
+ */
+uacpi_u64 uacpi_namespace_generation(void);
+
+/*
+ * Returns a counter that is incremented whenever a temporary node with a name
+ * that hashes to the same bucket as 'name' is installed or uninstalled.
+ */
+uacpi_u64 uacpi_namespace_name_generation(uacpi_object_name name);
+
 uacpi_namespace_node *uacpi_namespace_node_find_sub_node(
     uacpi_namespace_node *parent,
     uacpi_object_name name
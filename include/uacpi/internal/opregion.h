@@ -14,12 +14,6 @@ void uacpi_trace_region_io(
     uacpi_u64 offset, uacpi_u8 byte_size, uacpi_u64 ret
 );
 
-uacpi_status uacpi_install_address_space_handler_with_flags(
-    uacpi_namespace_node *device_node, enum uacpi_address_space space,
-    uacpi_region_handler handler, uacpi_handle handler_context,
-    uacpi_u16 flags
-);
-
 void uacpi_opregion_uninstall_handler(uacpi_namespace_node *node);
 
 uacpi_bool uacpi_address_space_handler_is_default(
@@ -36,7 +30,29 @@ uacpi_status uacpi_opregion_attach(uacpi_namespace_node *node);
 
 void uacpi_install_default_address_space_handlers(void);
 
-uacpi_status uacpi_dispatch_opregion_io(
-    uacpi_namespace_node *region_node, uacpi_u32 offset, uacpi_u8 byte_width,
-    uacpi_region_op op, uacpi_u64 *in_out
+/*
+ * Takes the opregion lock and attaches the region for a sequence of
+ * uacpi_opregion_io/uacpi_opregion_block_io calls, which is then finished
+ * with uacpi_opregion_io_end. Must be called with the namespace write lock
+ * held, which is dropped around every handler call.
+ */
+uacpi_status uacpi_opregion_io_begin(
+    uacpi_namespace_node *region_node, uacpi_object **out_obj
+);
+void uacpi_opregion_io_end(uacpi_object *region_obj);
+
+uacpi_status uacpi_opregion_io(
+    uacpi_namespace_node *region_node, uacpi_object *region_obj,
+    uacpi_u32 offset, uacpi_u8 byte_width, uacpi_region_op op,
+    uacpi_u64 *in_out
+);
+
+/*
+ * Returns UACPI_STATUS_UNIMPLEMENTED without performing any IO if the handler
+ * of the region doesn't support block access.
+ */
+uacpi_status uacpi_opregion_block_io(
+    uacpi_namespace_node *region_node, uacpi_object *region_obj,
+    uacpi_u32 offset, uacpi_u8 byte_width, uacpi_region_op op,
+    void *buffer, uacpi_size length
 );
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <uacpi/types.h>
+#include <uacpi/platform/config.h>
+#include <uacpi/internal/stdlib.h>
+
+#ifdef UACPI_POOL_ALLOCATOR
+
+/*
+ * Allocate/free a small fixed-size block from one of the internal pools.
+ * Requests that don't fit into any of the size classes are forwarded to the
+ * kernel allocator as is. 'size' must match between allocation and free.
+ */
+void *uacpi_pool_alloc(uacpi_size size);
+void *uacpi_pool_alloc_zeroed(uacpi_size size);
+void uacpi_pool_free(void *ptr, uacpi_size size);
+
+/*
+ * Switch every pool from the early atomic lock over to a kernel spinlock.
+ */
+uacpi_status uacpi_initialize_pools(void);
+
+/*
+ * Return memory of every pool that has no blocks in use back to the host.
+ * Pools that still have live blocks are left untouched.
+ */
+void uacpi_deinitialize_pools(void);
+
+#else
+
+#define uacpi_pool_alloc(size) uacpi_kernel_alloc(size)
+#define uacpi_pool_alloc_zeroed(size) uacpi_kernel_alloc_zeroed(size)
+#define uacpi_pool_free(ptr, size) uacpi_free(ptr, size)
+
+static inline uacpi_status uacpi_initialize_pools(void)
+{
+    return UACPI_STATUS_OK;
+}
+
+static inline void uacpi_deinitialize_pools(void) { }
+
+#endif
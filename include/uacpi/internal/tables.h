@@ -24,6 +24,7 @@ struct uacpi_installed_table {
 #define UACPI_TABLE_LOADED (1 << 0)
 #define UACPI_TABLE_CSUM_VERIFIED (1 << 1)
 #define UACPI_TABLE_INVALID (1 << 2)
+#define UACPI_TABLE_HEADER_PENDING (1 << 3)
     uacpi_u8 flags;
     uacpi_u8 origin;
 };
@@ -44,6 +45,15 @@ uacpi_status uacpi_table_install_with_origin(
 
 void uacpi_table_mark_as_loaded(uacpi_size idx);
 
+/*
+ * Take a reference to the table at 'idx', mapping it and verifying its
+ * checksum if needed. Unlike uacpi_table_ref, the potentially expensive
+ * mapping & checksum calculation are done without holding the table mutex,
+ * which makes this safe to call from worker threads while other tables are
+ * being loaded. The reference must be dropped via uacpi_table_unref.
+ */
+uacpi_status uacpi_table_prefetch(uacpi_size idx);
+
 uacpi_status uacpi_table_load_with_cause(
     uacpi_size idx, enum uacpi_table_load_cause cause
 );
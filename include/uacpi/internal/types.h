@@ -157,6 +157,24 @@ typedef uacpi_status (*uacpi_native_call_handler)(
     uacpi_handle ctx, uacpi_object *retval
 );
 
+/*
+ * A memoized result of resolving the NameString at 'offset' within a method
+ * while executing with 'scope' as the current scope. Only valid as long as
+ * 'generation' and 'name_generation' match the current namespace generation
+ * and the generation of the resolved node's name respectively.
+ *
+ * 'seq' is odd while the entry is being updated, see name_cache_lookup.
+ */
+typedef struct uacpi_cached_name {
+    uacpi_u32 seq;
+    uacpi_namespace_node *scope;
+    uacpi_namespace_node *node;
+    uacpi_u64 generation;
+    uacpi_u64 name_generation;
+    uacpi_u32 offset;
+    uacpi_u32 end_offset;
+} uacpi_cached_name;
+
 typedef struct uacpi_control_method {
     struct uacpi_shareable shareable;
     union {
@@ -164,6 +182,17 @@ typedef struct uacpi_control_method {
         uacpi_native_call_handler handler;
     };
     uacpi_mutex *mutex;
+
+    /*
+     * Lazily allocated array of 'size' pre-decoded entries indexed by AML
+     * code offset, see UACPI_DECODE_CACHE.
+     */
+    uacpi_u32 *decode_cache;
+
+    // Lazily allocated array of UACPI_NAME_CACHE_SIZE entries
+    uacpi_cached_name *name_cache;
+    uacpi_u32 call_count;
+
     uacpi_u32 size;
     uacpi_u8 sync_level : 4;
     uacpi_u8 args : 3;
@@ -171,6 +200,13 @@ typedef struct uacpi_control_method {
     uacpi_u8 named_objects_persist: 1;
     uacpi_u8 native_call : 1;
     uacpi_u8 owns_code : 1;
+
+    /*
+     * Set once an attempt to run this method with only the namespace read
+     * lock held had to be restarted with exclusive access. Such methods skip
+     * straight to exclusive execution from then on.
+     */
+    uacpi_u8 needs_exclusive_execution : 1;
 } uacpi_control_method;
 
 typedef enum uacpi_access_type {
@@ -43,3 +43,19 @@ uacpi_bool uacpi_is_valid_nameseg(uacpi_u8 *nameseg);
 void uacpi_free_dynamic_string(const uacpi_char *str);
 
 #define UACPI_NANOSECONDS_PER_SEC (1000ull * 1000ull * 1000ull)
+
+uacpi_status uacpi_initialize_utilities(void);
+void uacpi_deinitialize_utilities(void);
+
+/*
+ * Called after a table was loaded dynamically, drops any device information
+ * cached by the utilities (e.g. the PNP ID index) that might now be stale.
+ * Safe to call with the namespace lock held.
+ */
+void uacpi_utilities_invalidate_caches(void);
+
+/*
+ * Called whenever a _PRT might start returning something else, e.g. after a
+ * Notify to a PCI bridge. Safe to call with the namespace lock held.
+ */
+void uacpi_invalidate_pci_routing_cache(void);
@@ -263,6 +263,20 @@ typedef enum uacpi_work_type {
      * This can run on any CPU.
      */
     UACPI_WORK_NOTIFICATION,
+
+    /*
+     * Schedule _STA/_INI evaluation for a part of the namespace.
+     * This can run on any CPU, ideally on as many different ones as possible.
+     * Only used if uACPI is built with UACPI_PARALLEL_NAMESPACE_INIT.
+     */
+    UACPI_WORK_NAMESPACE_INITIALIZATION,
+
+    /*
+     * Schedule mapping & checksum verification of tables that are about to
+     * be loaded. This can run on any CPU.
+     * Only used if uACPI is built with UACPI_PARALLEL_TABLE_LOAD.
+     */
+    UACPI_WORK_TABLE_PREFETCH,
 } uacpi_work_type;
 
 typedef void (*uacpi_work_handler)(uacpi_handle);
@@ -131,6 +131,20 @@ const uacpi_char *uacpi_namespace_node_generate_absolute_path(
 );
 void uacpi_free_absolute_path(const uacpi_char *path);
 
+typedef struct uacpi_rw_lock_stats {
+    // Times a reader had to wait for an active or pending writer
+    uacpi_u32 read_contentions;
+
+    // Times a writer had to wait for another writer or for readers to leave
+    uacpi_u32 write_contentions;
+} uacpi_rw_lock_stats;
+
+/*
+ * Retrieve the contention statistics of the namespace reader/writer lock,
+ * these are accumulated since the last call to uacpi_initialize.
+ */
+uacpi_status uacpi_get_namespace_lock_stats(uacpi_rw_lock_stats *out_stats);
+
 #ifdef __cplusplus
 }
 #endif
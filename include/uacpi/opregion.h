@@ -19,6 +19,23 @@ uacpi_status uacpi_install_address_space_handler(
     uacpi_region_handler handler, uacpi_handle handler_context
 );
 
+/*
+ * The handler implements UACPI_REGION_OP_READ_BLOCK/WRITE_BLOCK, which are
+ * used instead of a series of UACPI_REGION_OP_READ/WRITE for fields that span
+ * multiple accesses.
+ */
+#define UACPI_ADDRESS_SPACE_HANDLER_BLOCK_ACCESS (1 << 1)
+
+/*
+ * Same as uacpi_install_address_space_handler, 'flags' is any combination of
+ * UACPI_ADDRESS_SPACE_HANDLER_* above.
+ */
+uacpi_status uacpi_install_address_space_handler_with_flags(
+    uacpi_namespace_node *device_node, enum uacpi_address_space space,
+    uacpi_region_handler handler, uacpi_handle handler_context,
+    uacpi_u16 flags
+);
+
 /*
  * Uninstall the handler of type 'space' from a given device node.
  */
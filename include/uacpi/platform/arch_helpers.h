@@ -10,6 +10,20 @@
 #define UACPI_ARCH_FLUSH_CPU_CACHE() do {} while (0)
 #endif
 
+/*
+ * Executed on every iteration of an internal busy-wait loop, should tell the
+ * CPU that the current thread is spinning (e.g. 'pause' on x86).
+ */
+#ifndef UACPI_ARCH_SPIN_LOOP_HINT
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UACPI_ARCH_SPIN_LOOP_HINT() __builtin_ia32_pause()
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+#define UACPI_ARCH_SPIN_LOOP_HINT() __asm__ __volatile__("yield")
+#else
+#define UACPI_ARCH_SPIN_LOOP_HINT() do {} while (0)
+#endif
+#endif
+
 typedef unsigned long uacpi_cpu_flags;
 
 typedef void *uacpi_thread_id;
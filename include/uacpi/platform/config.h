@@ -74,6 +74,119 @@ UACPI_BUILD_BUG_ON_WITH_MSG(
  */
 // #define UACPI_NATIVE_ALLOC_ZEROED
 
+/*
+ * Makes uacpi_namespace_initialize evaluate _STA/_INI for the independent
+ * device subtrees directly under \_SB concurrently. This is done by scheduling
+ * up to UACPI_NAMESPACE_INIT_WORKERS work items of type
+ * UACPI_WORK_NAMESPACE_INITIALIZATION via uacpi_kernel_schedule_work, which
+ * the host is expected to run on any available CPU. Everything outside of
+ * \_SB is initialized serially, at its usual position in the namespace walk.
+ *
+ * Subtrees are handed out in namespace order, and workers only run methods
+ * that complete with the namespace read lock held, i.e. without modifying any
+ * global state. As soon as a method needs exclusive access (e.g. an _INI that
+ * stores to a named object, acquires a mutex or touches an operation region),
+ * that subtree and every one after it are initialized again serially and in
+ * order, exactly as they would be without this option.
+ */
+// #define UACPI_PARALLEL_NAMESPACE_INIT
+
+#ifndef UACPI_NAMESPACE_INIT_WORKERS
+#define UACPI_NAMESPACE_INIT_WORKERS 4
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_NAMESPACE_INIT_WORKERS < 1,
+    "configured namespace initialization worker count is invalid "
+    "(expecting at least 1 worker)"
+);
+
+/*
+ * Makes uacpi_namespace_load map & verify the checksums of all SSDTs/PSDTs on
+ * up to UACPI_TABLE_LOAD_WORKERS work items of type UACPI_WORK_TABLE_PREFETCH
+ * scheduled via uacpi_kernel_schedule_work, while the DSDT and preceding
+ * tables are being executed. Definition blocks are still loaded one by one,
+ * in the same order as without this option.
+ */
+// #define UACPI_PARALLEL_TABLE_LOAD
+
+#ifndef UACPI_TABLE_LOAD_WORKERS
+#define UACPI_TABLE_LOAD_WORKERS 2
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_TABLE_LOAD_WORKERS < 1,
+    "configured table load worker count is invalid "
+    "(expecting at least 1 worker)"
+);
+
+/*
+ * Makes uACPI allocate its most common small structures (objects, namespace
+ * nodes, buffer & package headers and small package element arrays) from
+ * internal fixed-size pools carved out of UACPI_POOL_CHUNK_SIZE chunks,
+ * instead of going to uacpi_kernel_alloc for every one of them. This cuts
+ * down on host allocator churn considerably during table load and method
+ * execution. Pool usage statistics are available via uacpi_get_pool_stats.
+ *
+ * Pools are protected by kernel spinlocks once uacpi_initialize has been
+ * called. Before that they fall back to a plain atomic lock that doesn't
+ * disable interrupts, so early users (e.g. the resource API) must not run in
+ * interrupt context.
+ */
+// #define UACPI_POOL_ALLOCATOR
+
+/*
+ * By default uacpi_eval() first attempts to run control methods with only the
+ * namespace read lock held, which lets methods that don't modify any global
+ * state (e.g. most _STA, _HID, _PRW implementations) run concurrently. Methods
+ * that turn out to need exclusive access are transparently restarted with the
+ * write lock held before they perform any side effects.
+ *
+ * Define this to always execute control methods with the namespace write lock
+ * held, serializing all AML execution.
+ */
+// #define UACPI_EXCLUSIVE_METHOD_EXECUTION
+
+/*
+ * Makes uacpi_find_devices_at look up candidate devices in an index of all
+ * IDs reported via _HID & _CID, instead of walking the entire namespace and
+ * evaluating both methods for every device on every call. The index is built
+ * on first use after uacpi_namespace_initialize and rebuilt lazily after
+ * dynamic table loads.
+ *
+ * Candidates are always re-matched against their current _HID & _CID, but a
+ * device whose IDs change at runtime to a new value is only found after the
+ * next rebuild.
+ */
+// #define UACPI_PNP_ID_INDEX
+
+/*
+ * Makes uACPI keep the parsed & validated _PRT of every PCI bridge queried via
+ * uacpi_get_pci_routing_table or uacpi_get_pci_route, so that subsequent
+ * calls don't execute any AML. The cache is dropped on every Notify to a
+ * device, dynamic table load and call to uacpi_set_interrupt_model.
+ */
+// #define UACPI_PCI_ROUTING_CACHE
+
+/*
+ * Makes uacpi_initialize skip reading the headers of the tables listed in the
+ * RSDT/XSDT, past the FADT. These tables are only recorded by their physical
+ * address, while their headers are read the first time a table lookup or
+ * iteration reaches them, several adjacent headers per mapping.
+ *
+ * Note that the RSDT/XSDT doesn't record table signatures, so a lookup by
+ * signature has to read the headers of every table it walks past, and loading
+ * the namespace (which looks for all SSDTs) ends up reading all of them. What
+ * is saved is the per-table header mapping during uacpi_initialize, and most
+ * of the headers past the match for lookups done before the namespace is
+ * loaded. Table contents are still only mapped once a table is referenced.
+ *
+ * This is not done if UACPI_FLAG_PROACTIVE_TBL_CSUM is set, or if a table
+ * installation handler is already registered by the time uacpi_initialize is
+ * called, as both need to see every table at installation time.
+ */
+// #define UACPI_LAZY_TABLE_HEADERS
+
 /*
  * =========================
  * Platform-specific options
@@ -127,4 +240,141 @@ UACPI_BUILD_BUG_ON_WITH_MSG(
     "configured static table array length is too small (expecting at least 1)"
 );
 
+/*
+ * The default SystemMemory operation region handler maps regions lazily, in
+ * windows of this many bytes aligned to the same boundary, instead of mapping
+ * the entire region up front. Regions that fit within a single window are
+ * mapped in their entirety on first access. Must be a power of two.
+ */
+#ifndef UACPI_MEMORY_REGION_WINDOW_SIZE
+    #define UACPI_MEMORY_REGION_WINDOW_SIZE 4096
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_MEMORY_REGION_WINDOW_SIZE < 16 ||
+    (UACPI_MEMORY_REGION_WINDOW_SIZE &
+     (UACPI_MEMORY_REGION_WINDOW_SIZE - 1)) != 0,
+    "configured memory region window size must be a power of two "
+    "(expecting at least 16 bytes)"
+);
+
+/*
+ * The number of windows the default SystemMemory operation region handler
+ * keeps mapped per region. The least recently used window is unmapped once
+ * an access falls outside of all of them.
+ */
+#ifndef UACPI_MEMORY_REGION_MAX_WINDOWS
+    #define UACPI_MEMORY_REGION_MAX_WINDOWS 4
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_MEMORY_REGION_MAX_WINDOWS < 1,
+    "configured memory region window count is invalid "
+    "(expecting at least 1 window)"
+);
+
+/*
+ * The number of times a control method has to be invoked before uACPI starts
+ * caching its resolved names (and, with UACPI_DECODE_CACHE, its decoded
+ * opcodes and package lengths). This allows frequently called methods (e.g.
+ * _STA or EC query handlers) to skip the namespace lookups on subsequent
+ * calls. Calls executed with only the namespace read lock held count towards
+ * the threshold and populate the caches like any other call, the caches are
+ * updated atomically. Setting this to 0 disables the caches entirely.
+ */
+#ifndef UACPI_DECODE_CACHE_CALL_THRESHOLD
+    #define UACPI_DECODE_CACHE_CALL_THRESHOLD 8
+#endif
+
+/*
+ * Makes methods that cross UACPI_DECODE_CACHE_CALL_THRESHOLD also remember the
+ * opcode and PkgLength decoded at every AML offset. This only saves the raw
+ * byte reads of the opcode and PkgLength encodings, but takes up four bytes
+ * per byte of AML of every such method, so it's only worth enabling on hosts
+ * where reading AML is unusually slow.
+ */
+// #define UACPI_DECODE_CACHE
+
+/*
+ * The number of name resolution results cached per method once the method
+ * crosses UACPI_DECODE_CACHE_CALL_THRESHOLD. Each entry is approximately 48
+ * bytes. Must be a power of two, setting this to 0 disables the cache.
+ */
+#ifndef UACPI_NAME_CACHE_SIZE
+    #define UACPI_NAME_CACHE_SIZE 32
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    (UACPI_NAME_CACHE_SIZE & (UACPI_NAME_CACHE_SIZE - 1)) != 0,
+    "configured name cache size must be a power of two"
+);
+
+/*
+ * The number of entries in the cache of control method results. Only methods
+ * that take no arguments and are proven to be side-effect free by completing
+ * under the namespace read lock (no opregion access, stores to named objects,
+ * Notify, Sleep etc.) are cached, so repeated evaluations of e.g. _HID, _CID
+ * or _UID during device matching don't have to run the interpreter at all.
+ * Results that depend on Timer or _OSI are never cached.
+ *
+ * The whole cache is invalidated every time the namespace write lock is
+ * released, i.e. after any AML with side effects, table load or namespace
+ * change.
+ *
+ * Must be a power of two, setting this to 0 (default) disables the cache.
+ */
+#ifndef UACPI_EVAL_CACHE_SIZE
+    #define UACPI_EVAL_CACHE_SIZE 0
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    (UACPI_EVAL_CACHE_SIZE & (UACPI_EVAL_CACHE_SIZE - 1)) != 0,
+    "configured eval cache size must be a power of two"
+);
+
+/*
+ * The number of children a namespace node must have before uACPI builds a
+ * hashed index of them. This turns child lookups in wide scopes (e.g. \_SB or
+ * \_GPE on large server firmware) from a linear list walk into a hash table
+ * lookup, at the cost of an extra pointer per namespace node. Setting this to
+ * 0 compiles the index out entirely, leaving the plain list-only layout.
+ */
+#ifndef UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD
+    #define UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD 32
+#endif
+
+/*
+ * The size of a single chunk requested from the host by the pool allocator,
+ * only used if UACPI_POOL_ALLOCATOR is enabled.
+ */
+#ifndef UACPI_POOL_CHUNK_SIZE
+    #define UACPI_POOL_CHUNK_SIZE 4096
+#endif
+
+/*
+ * The size of a single chunk requested from the host by the per-execution
+ * arena, which backs the interpreter's call stack, pending ops and other
+ * scratch storage that only lives as long as a control method invocation.
+ */
+#ifndef UACPI_EXECUTION_ARENA_CHUNK_SIZE
+    #define UACPI_EXECUTION_ARENA_CHUNK_SIZE 4096
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_EXECUTION_ARENA_CHUNK_SIZE < 256,
+    "UACPI_EXECUTION_ARENA_CHUNK_SIZE must be at least 256 bytes"
+);
+
+/*
+ * The number of execution contexts kept around for reuse by
+ * uacpi_execute_control_method(), including their arena memory. Every
+ * concurrent evaluation takes a context out of the pool and falls back to a
+ * fresh allocation if none are available.
+ *
+ * 0 disables the pool, making every evaluation allocate its own context.
+ */
+#ifndef UACPI_EXECUTION_CONTEXT_POOL_SIZE
+    #define UACPI_EXECUTION_CONTEXT_POOL_SIZE 4
+#endif
+
 #endif
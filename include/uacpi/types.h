@@ -359,6 +359,13 @@ typedef enum uacpi_region_op {
     UACPI_REGION_OP_READ = 2,
     UACPI_REGION_OP_WRITE = 3,
     UACPI_REGION_OP_DETACH = 4,
+
+    /*
+     * Only passed to handlers installed with
+     * UACPI_ADDRESS_SPACE_HANDLER_BLOCK_ACCESS, see uacpi_region_block_rw_data.
+     */
+    UACPI_REGION_OP_READ_BLOCK = 5,
+    UACPI_REGION_OP_WRITE_BLOCK = 6,
 } uacpi_region_op;
 
 typedef struct uacpi_region_attach_data {
@@ -378,6 +385,25 @@ typedef struct uacpi_region_rw_data {
     uacpi_u8 byte_width;
 } uacpi_region_rw_data;
 
+/*
+ * A block operation is equivalent to 'length / byte_width' consecutive
+ * UACPI_REGION_OP_READ/WRITE operations of 'byte_width' bytes each, starting
+ * at 'address' (or 'offset') and moving upwards, with the values stored in
+ * 'buffer' in little-endian order. 'length' is always a multiple of
+ * 'byte_width'.
+ */
+typedef struct uacpi_region_block_rw_data {
+    void *handler_context;
+    void *region_context;
+    union {
+        uacpi_phys_addr address;
+        uacpi_u64 offset;
+    };
+    void *buffer;
+    uacpi_size length;
+    uacpi_u8 byte_width;
+} uacpi_region_block_rw_data;
+
 typedef struct uacpi_region_detach_data {
     void *handler_context;
     void *region_context;
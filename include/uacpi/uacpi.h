@@ -214,6 +214,29 @@ uacpi_status uacpi_eval_simple_package(
     uacpi_namespace_node *parent, const uacpi_char *path, uacpi_object **ret
 );
 
+/*
+ * Evaluate the same 'path' with the same 'args' relative to each of the
+ * 'count' nodes in 'parents', e.g. _STA or _ADR of every device of interest.
+ * This is equivalent to calling uacpi_eval() for every node in array order,
+ * except that the namespace lock is only taken once (or twice, if some node
+ * needs exclusive access) for the entire batch, and the path is only parsed
+ * once.
+ *
+ * The status of every individual evaluation is stored in the respective
+ * element of 'out_statuses', while the returned objects are stored in
+ * 'out_objs', which may be NULL if the return values are not needed. Both
+ * arrays must have room for 'count' elements. All elements of 'out_objs'
+ * are set to NULL before any evaluation takes place.
+ *
+ * The return value of this function only reflects errors that prevented the
+ * batch from being evaluated at all.
+ */
+uacpi_status uacpi_eval_batch(
+    uacpi_namespace_node *const *parents, uacpi_size count,
+    const uacpi_char *path, const uacpi_object_array *args,
+    uacpi_status *out_statuses, uacpi_object **out_objs
+);
+
 /*
  * Get the bitness of the currently loaded AML code according to the DSDT.
  *
@@ -253,6 +276,26 @@ uacpi_status uacpi_release_global_lock(uacpi_u32 seq);
  */
 void uacpi_state_reset(void);
 
+typedef struct uacpi_pool_stats {
+    // Size of every block handed out by this pool
+    uacpi_size block_size;
+
+    // Number of UACPI_POOL_CHUNK_SIZE chunks currently allocated from the host
+    uacpi_size num_chunks;
+
+    uacpi_size blocks_in_use;
+    uacpi_size peak_blocks_in_use;
+    uacpi_u64 total_allocations;
+} uacpi_pool_stats;
+
+/*
+ * Retrieve the statistics of the internal allocation pool at index 'idx'.
+ * Pools are numbered from 0, UACPI_STATUS_NOT_FOUND is returned for any index
+ * past the last pool. Returns UACPI_STATUS_COMPILED_OUT if uACPI was built
+ * without UACPI_POOL_ALLOCATOR.
+ */
+uacpi_status uacpi_get_pool_stats(uacpi_u32 idx, uacpi_pool_stats *out_stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -68,6 +68,21 @@ uacpi_status uacpi_get_pci_routing_table(
     uacpi_namespace_node *parent, uacpi_pci_routing_table **out_table
 );
 
+/*
+ * Find the _PRT entry of 'bridge' that describes how 'pin' (0 for INTA through
+ * 3 for INTD) of the PCI device at slot 'device' is routed.
+ *
+ * If the returned entry has no 'source', 'index' is the GSI the pin is
+ * hardwired to. Otherwise, 'index' selects the interrupt resource of the
+ * 'source' link device that the pin is routed to.
+ *
+ * Returns UACPI_STATUS_NOT_FOUND if the _PRT has no entry for this device/pin.
+ */
+uacpi_status uacpi_get_pci_route(
+    uacpi_namespace_node *bridge, uacpi_u16 device, uacpi_u8 pin,
+    uacpi_pci_routing_table_entry *out_entry
+);
+
 typedef struct uacpi_id_string {
     // size of the string including the null byte
     uacpi_u32 size;
@@ -0,0 +1,217 @@
+#include <uacpi/internal/arena.h>
+#include <uacpi/internal/stdlib.h>
+#include <uacpi/kernel_api.h>
+
+#define ARENA_ALIGNMENT 16
+
+struct uacpi_arena_chunk {
+    struct uacpi_arena_chunk *next;
+
+    // Usable bytes following the header
+    uacpi_size capacity;
+    uacpi_size used;
+};
+
+/*
+ * Stored inside the freed allocation itself, which is why every allocation
+ * is at least ARENA_ALIGNMENT bytes large.
+ */
+struct uacpi_arena_free_block {
+    struct uacpi_arena_free_block *next;
+    uacpi_size size;
+};
+
+#define ARENA_CHUNK_HEADER_SIZE \
+    UACPI_ALIGN_UP(sizeof(struct uacpi_arena_chunk), ARENA_ALIGNMENT, uacpi_size)
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    sizeof(struct uacpi_arena_free_block) > ARENA_ALIGNMENT,
+    "arena free block header doesn't fit into the smallest allocation"
+);
+
+static uacpi_u8 *chunk_data(struct uacpi_arena_chunk *chunk)
+{
+    return (uacpi_u8*)chunk + ARENA_CHUNK_HEADER_SIZE;
+}
+
+static uacpi_size arena_round_size(uacpi_size size)
+{
+    if (size == 0)
+        size = 1;
+
+    return UACPI_ALIGN_UP(size, ARENA_ALIGNMENT, uacpi_size);
+}
+
+static uacpi_bool is_last_allocation(
+    struct uacpi_arena *arena, void *ptr, uacpi_size size
+)
+{
+    struct uacpi_arena_chunk *chunk = arena->chunks;
+
+    if (chunk == UACPI_NULL)
+        return UACPI_FALSE;
+
+    return (uacpi_u8*)ptr + size == chunk_data(chunk) + chunk->used;
+}
+
+/*
+ * After rewinding the bump pointer, free blocks that now end right at the top
+ * of the current chunk must be absorbed back into it. Otherwise they would be
+ * handed out twice: once from the free list and once by bumping.
+ */
+static void arena_absorb_free_blocks(struct uacpi_arena *arena)
+{
+    struct uacpi_arena_free_block *block, **prev_next;
+
+restart:
+    prev_next = &arena->free_blocks;
+    for (block = arena->free_blocks; block; block = block->next) {
+        if (is_last_allocation(arena, block, block->size)) {
+            *prev_next = block->next;
+            arena->chunks->used -= block->size;
+            goto restart;
+        }
+
+        prev_next = &block->next;
+    }
+}
+
+static struct uacpi_arena_chunk *arena_grow(
+    struct uacpi_arena *arena, uacpi_size size
+)
+{
+    struct uacpi_arena_chunk *chunk;
+    uacpi_size capacity;
+
+    capacity = UACPI_EXECUTION_ARENA_CHUNK_SIZE - ARENA_CHUNK_HEADER_SIZE;
+    capacity = UACPI_MAX(capacity, size);
+
+    chunk = uacpi_kernel_alloc(ARENA_CHUNK_HEADER_SIZE + capacity);
+    if (uacpi_unlikely(chunk == UACPI_NULL))
+        return UACPI_NULL;
+
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    return chunk;
+}
+
+void *uacpi_arena_alloc(struct uacpi_arena *arena, uacpi_size size)
+{
+    struct uacpi_arena_free_block *block, **prev_next;
+    struct uacpi_arena_chunk *chunk;
+    void *ret;
+
+    size = arena_round_size(size);
+
+    prev_next = &arena->free_blocks;
+    for (block = arena->free_blocks; block; block = block->next) {
+        if (block->size == size) {
+            *prev_next = block->next;
+            return block;
+        }
+
+        prev_next = &block->next;
+    }
+
+    chunk = arena->chunks;
+    if (chunk == UACPI_NULL || (chunk->capacity - chunk->used) < size) {
+        chunk = arena_grow(arena, size);
+        if (uacpi_unlikely(chunk == UACPI_NULL))
+            return UACPI_NULL;
+    }
+
+    ret = chunk_data(chunk) + chunk->used;
+    chunk->used += size;
+    return ret;
+}
+
+void uacpi_arena_free(struct uacpi_arena *arena, void *ptr, uacpi_size size)
+{
+    struct uacpi_arena_free_block *block;
+
+    if (ptr == UACPI_NULL)
+        return;
+
+    size = arena_round_size(size);
+
+    if (is_last_allocation(arena, ptr, size)) {
+        arena->chunks->used -= size;
+        arena_absorb_free_blocks(arena);
+        return;
+    }
+
+    block = ptr;
+    block->size = size;
+    block->next = arena->free_blocks;
+    arena->free_blocks = block;
+}
+
+void *uacpi_arena_realloc(
+    struct uacpi_arena *arena, void *ptr, uacpi_size old_size,
+    uacpi_size new_size
+)
+{
+    struct uacpi_arena_chunk *chunk = arena->chunks;
+    uacpi_size rounded_old, rounded_new;
+    void *ret;
+
+    if (ptr == UACPI_NULL)
+        return uacpi_arena_alloc(arena, new_size);
+
+    rounded_old = arena_round_size(old_size);
+    rounded_new = arena_round_size(new_size);
+
+    if (is_last_allocation(arena, ptr, rounded_old) &&
+        (chunk->used - rounded_old) + rounded_new <= chunk->capacity) {
+        chunk->used -= rounded_old;
+        chunk->used += rounded_new;
+        return ptr;
+    }
+
+    ret = uacpi_arena_alloc(arena, new_size);
+    if (uacpi_unlikely(ret == UACPI_NULL))
+        return UACPI_NULL;
+
+    uacpi_memcpy(ret, ptr, UACPI_MIN(old_size, new_size));
+    uacpi_arena_free(arena, ptr, old_size);
+    return ret;
+}
+
+void uacpi_arena_reset(struct uacpi_arena *arena)
+{
+    struct uacpi_arena_chunk *chunk, *next, *retained = UACPI_NULL;
+
+    for (chunk = arena->chunks; chunk; chunk = next) {
+        next = chunk->next;
+
+        // Only keep the first chunk, as long as it's of the default size
+        if (next == UACPI_NULL && chunk->capacity ==
+            UACPI_EXECUTION_ARENA_CHUNK_SIZE - ARENA_CHUNK_HEADER_SIZE) {
+            retained = chunk;
+            break;
+        }
+
+        uacpi_free(chunk, ARENA_CHUNK_HEADER_SIZE + chunk->capacity);
+    }
+
+    if (retained != UACPI_NULL)
+        retained->used = 0;
+
+    arena->chunks = retained;
+    arena->free_blocks = UACPI_NULL;
+}
+
+void uacpi_arena_deinit(struct uacpi_arena *arena)
+{
+    struct uacpi_arena_chunk *chunk, *next;
+
+    for (chunk = arena->chunks; chunk; chunk = next) {
+        next = chunk->next;
+        uacpi_free(chunk, ARENA_CHUNK_HEADER_SIZE + chunk->capacity);
+    }
+
+    arena->chunks = UACPI_NULL;
+    arena->free_blocks = UACPI_NULL;
+}
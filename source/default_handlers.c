@@ -1,6 +1,7 @@
 #include <uacpi/internal/opregion.h>
 #include <uacpi/internal/namespace.h>
 #include <uacpi/internal/utilities.h>
+#include <uacpi/internal/stdlib.h>
 #include <uacpi/internal/helpers.h>
 #include <uacpi/internal/log.h>
 #include <uacpi/internal/io.h>
@@ -134,10 +135,22 @@ static uacpi_status handle_pci_region(uacpi_region_op op, uacpi_handle op_data)
     }
 }
 
-struct memory_region_ctx {
+struct memory_region_window {
     uacpi_phys_addr phys;
     uacpi_u8 *virt;
+
+    // 0 if this window is not mapped
+    uacpi_size size;
+
+    uacpi_u64 last_use;
+};
+
+struct memory_region_ctx {
+    uacpi_phys_addr phys;
     uacpi_size size;
+
+    uacpi_u64 use_counter;
+    struct memory_region_window windows[UACPI_MEMORY_REGION_MAX_WINDOWS];
 };
 
 static uacpi_status memory_region_attach(uacpi_region_attach_data *data)
@@ -147,30 +160,23 @@ static uacpi_status memory_region_attach(uacpi_region_attach_data *data)
     uacpi_operation_region *op_region;
     uacpi_status ret;
 
-    ctx = uacpi_kernel_alloc(sizeof(*ctx));
-    if (ctx == UACPI_NULL)
-        return UACPI_STATUS_OUT_OF_MEMORY;
-
     ret = uacpi_namespace_node_acquire_object_typed(
         data->region_node, UACPI_OBJECT_OPERATION_REGION_BIT, &region_obj
     );
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    op_region = region_obj->op_region;
-    ctx->size = op_region->length;
-
-    // FIXME: this really shouldn't try to map everything at once
-    ctx->phys = op_region->offset;
-    ctx->virt = uacpi_kernel_map(ctx->phys, ctx->size);
-
-    if (uacpi_unlikely(ctx->virt == UACPI_NULL)) {
-        ret = UACPI_STATUS_MAPPING_FAILED;
-        uacpi_trace_region_error(data->region_node, "unable to map", ret);
-        uacpi_free(ctx, sizeof(*ctx));
+    ctx = uacpi_kernel_alloc_zeroed(sizeof(*ctx));
+    if (ctx == UACPI_NULL) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
         goto out;
     }
 
+    // Nothing is mapped until the first access, see memory_region_map
+    op_region = region_obj->op_region;
+    ctx->phys = op_region->offset;
+    ctx->size = op_region->length;
+
     data->out_region_context = ctx;
 out:
     uacpi_namespace_node_release_object(region_obj);
@@ -180,12 +186,91 @@ out:
 static uacpi_status memory_region_detach(uacpi_region_detach_data *data)
 {
     struct memory_region_ctx *ctx = data->region_context;
+    struct memory_region_window *window;
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_MEMORY_REGION_MAX_WINDOWS; ++i) {
+        window = &ctx->windows[i];
+
+        if (window->size != 0)
+            uacpi_kernel_unmap(window->virt, window->size);
+    }
 
-    uacpi_kernel_unmap(ctx->virt, ctx->size);
     uacpi_free(ctx, sizeof(*ctx));
     return UACPI_STATUS_OK;
 }
 
+/*
+ * Returns a pointer to [address, address + length) within the region, mapping
+ * the window(s) containing it in place of the least recently used mapping if
+ * needed. Region handlers are serialized by the opregion lock, so this needs
+ * no locking of its own.
+ */
+static uacpi_status memory_region_map(
+    struct memory_region_ctx *ctx, uacpi_phys_addr address, uacpi_size length,
+    uacpi_u8 **out_ptr
+)
+{
+    struct memory_region_window *window, *victim = UACPI_NULL;
+    uacpi_phys_addr start, end, region_end;
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_MEMORY_REGION_MAX_WINDOWS; ++i) {
+        window = &ctx->windows[i];
+
+        if (window->size == 0) {
+            if (victim == UACPI_NULL || victim->size != 0)
+                victim = window;
+            continue;
+        }
+
+        if (address >= window->phys &&
+            address + length <= window->phys + window->size) {
+            window->last_use = ++ctx->use_counter;
+            *out_ptr = window->virt + (address - window->phys);
+            return UACPI_STATUS_OK;
+        }
+
+        if (victim == UACPI_NULL ||
+            (victim->size != 0 && window->last_use < victim->last_use))
+            victim = window;
+    }
+
+    region_end = ctx->phys + ctx->size;
+
+    if (ctx->size <= UACPI_MEMORY_REGION_WINDOW_SIZE) {
+        start = ctx->phys;
+        end = region_end;
+    } else {
+        start = UACPI_ALIGN_DOWN(
+            address, UACPI_MEMORY_REGION_WINDOW_SIZE, uacpi_phys_addr
+        );
+        end = UACPI_ALIGN_UP(
+            address + length, UACPI_MEMORY_REGION_WINDOW_SIZE,
+            uacpi_phys_addr
+        );
+
+        start = UACPI_MAX(start, ctx->phys);
+        end = UACPI_MIN(end, region_end);
+    }
+
+    if (victim->size != 0) {
+        uacpi_kernel_unmap(victim->virt, victim->size);
+        victim->size = 0;
+    }
+
+    victim->virt = uacpi_kernel_map(start, end - start);
+    if (uacpi_unlikely(victim->virt == UACPI_NULL))
+        return UACPI_STATUS_MAPPING_FAILED;
+
+    victim->phys = start;
+    victim->size = end - start;
+    victim->last_use = ++ctx->use_counter;
+
+    *out_ptr = victim->virt + (address - start);
+    return UACPI_STATUS_OK;
+}
+
 struct io_region_ctx {
     uacpi_io_addr base;
     uacpi_handle handle;
@@ -242,14 +327,38 @@ static uacpi_status memory_region_do_rw(
 {
     struct memory_region_ctx *ctx = data->region_context;
     uacpi_u8 *ptr;
+    uacpi_status ret;
 
-    ptr = ctx->virt + (data->address - ctx->phys);
+    ret = memory_region_map(ctx, data->address, data->byte_width, &ptr);
+    if (uacpi_unlikely_error(ret))
+        return ret;
 
     return op == UACPI_REGION_OP_READ ?
         uacpi_system_memory_read(ptr, data->byte_width, &data->value) :
         uacpi_system_memory_write(ptr, data->byte_width, data->value);
 }
 
+static uacpi_status memory_region_do_block_rw(
+    uacpi_region_op op, uacpi_region_block_rw_data *data
+)
+{
+    struct memory_region_ctx *ctx = data->region_context;
+    uacpi_u8 *ptr;
+    uacpi_status ret;
+
+    ret = memory_region_map(ctx, data->address, data->length, &ptr);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    return op == UACPI_REGION_OP_READ_BLOCK ?
+        uacpi_system_memory_read_block(
+            ptr, data->byte_width, data->buffer, data->length
+        ) :
+        uacpi_system_memory_write_block(
+            ptr, data->byte_width, data->buffer, data->length
+        );
+}
+
 static uacpi_status handle_memory_region(uacpi_region_op op, uacpi_handle op_data)
 {
     switch (op) {
@@ -260,6 +369,9 @@ static uacpi_status handle_memory_region(uacpi_region_op op, uacpi_handle op_dat
     case UACPI_REGION_OP_READ:
     case UACPI_REGION_OP_WRITE:
         return memory_region_do_rw(op, op_data);
+    case UACPI_REGION_OP_READ_BLOCK:
+    case UACPI_REGION_OP_WRITE_BLOCK:
+        return memory_region_do_block_rw(op, op_data);
     default:
         return UACPI_STATUS_INVALID_ARGUMENT;
     }
@@ -276,6 +388,21 @@ static uacpi_status table_data_region_do_rw(
        uacpi_system_memory_write(addr, data->byte_width, data->value);
 }
 
+static uacpi_status table_data_region_do_block_rw(
+    uacpi_region_op op, uacpi_region_block_rw_data *data
+)
+{
+    void *addr = UACPI_VIRT_ADDR_TO_PTR((uacpi_virt_addr)data->offset);
+
+    // Table data is always plain RAM, so access width doesn't matter here
+    if (op == UACPI_REGION_OP_READ_BLOCK)
+        uacpi_memcpy(data->buffer, addr, data->length);
+    else
+        uacpi_memcpy(addr, data->buffer, data->length);
+
+    return UACPI_STATUS_OK;
+}
+
 static uacpi_status handle_table_data_region(uacpi_region_op op, uacpi_handle op_data)
 {
     switch (op) {
@@ -285,6 +412,9 @@ static uacpi_status handle_table_data_region(uacpi_region_op op, uacpi_handle op
     case UACPI_REGION_OP_READ:
     case UACPI_REGION_OP_WRITE:
         return table_data_region_do_rw(op, op_data);
+    case UACPI_REGION_OP_READ_BLOCK:
+    case UACPI_REGION_OP_WRITE_BLOCK:
+        return table_data_region_do_block_rw(op, op_data);
     default:
         return UACPI_STATUS_INVALID_ARGUMENT;
     }
@@ -330,7 +460,8 @@ void uacpi_install_default_address_space_handlers(void)
     uacpi_install_address_space_handler_with_flags(
         root, UACPI_ADDRESS_SPACE_SYSTEM_MEMORY,
         handle_memory_region, UACPI_NULL,
-        UACPI_ADDRESS_SPACE_HANDLER_DEFAULT
+        UACPI_ADDRESS_SPACE_HANDLER_DEFAULT |
+        UACPI_ADDRESS_SPACE_HANDLER_BLOCK_ACCESS
     );
 
     uacpi_install_address_space_handler_with_flags(
@@ -348,6 +479,7 @@ void uacpi_install_default_address_space_handlers(void)
     uacpi_install_address_space_handler_with_flags(
         root, UACPI_ADDRESS_SPACE_TABLE_DATA,
         handle_table_data_region, UACPI_NULL,
-        UACPI_ADDRESS_SPACE_HANDLER_DEFAULT
+        UACPI_ADDRESS_SPACE_HANDLER_DEFAULT |
+        UACPI_ADDRESS_SPACE_HANDLER_BLOCK_ACCESS
     );
 }
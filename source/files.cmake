@@ -18,4 +18,6 @@ uacpi_add_sources(
     event.c
     mutex.c
     osi.c
+    pool.c
+    arena.c
 )
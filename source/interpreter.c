@@ -1,3 +1,5 @@
+#include <uacpi/platform/config.h>
+
 #include <uacpi/internal/types.h>
 #include <uacpi/internal/interpreter.h>
 #include <uacpi/internal/dynamic_array.h>
@@ -17,6 +19,7 @@
 #include <uacpi/internal/event.h>
 #include <uacpi/internal/mutex.h>
 #include <uacpi/internal/osi.h>
+#include <uacpi/platform/atomic.h>
 
 enum item_type {
     ITEM_NONE = 0,
@@ -45,7 +48,7 @@ struct item {
 };
 
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(item_array, struct item, 8)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(item_array, struct item, static)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(item_array, struct item, static)
 
 struct op_context {
     uacpi_u8 pc;
@@ -62,7 +65,7 @@ struct op_context {
 };
 
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(op_context_array, struct op_context, 8)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(
     op_context_array, struct op_context, static
 )
 
@@ -97,22 +100,23 @@ struct code_block {
 };
 
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(code_block_array, struct code_block, 8)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(
     code_block_array, struct code_block, static
 )
 
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(held_mutexes_array, uacpi_mutex*, 8)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(
     held_mutexes_array, uacpi_mutex*, static
 )
 
 static uacpi_status held_mutexes_array_push(
-    struct held_mutexes_array *arr, uacpi_mutex *mutex
+    struct held_mutexes_array *arr, struct uacpi_arena *arena,
+    uacpi_mutex *mutex
 )
 {
     uacpi_mutex **slot;
 
-    slot = held_mutexes_array_alloc(arr);
+    slot = held_mutexes_array_alloc(arr, arena);
     if (uacpi_unlikely(slot == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
@@ -242,17 +246,18 @@ do_release:
 
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(
     temp_namespace_node_array, uacpi_namespace_node*, 8)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(
     temp_namespace_node_array, uacpi_namespace_node*, static
 )
 
 static uacpi_status temp_namespace_node_array_push(
-    struct temp_namespace_node_array *arr, uacpi_namespace_node *node
+    struct temp_namespace_node_array *arr, struct uacpi_arena *arena,
+    uacpi_namespace_node *node
 )
 {
     uacpi_namespace_node **slot;
 
-    slot = temp_namespace_node_array_alloc(arr);
+    slot = temp_namespace_node_array_alloc(arr, arena);
     if (uacpi_unlikely(slot == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
@@ -297,7 +302,7 @@ static uacpi_bool call_frame_has_code(struct call_frame *frame)
 }
 
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(call_frame_array, struct call_frame, 4)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(
     call_frame_array, struct call_frame, static
 )
 
@@ -321,6 +326,18 @@ struct execution_context {
     struct call_frame_array call_stack;
     struct held_mutexes_array held_mutexes;
 
+    /*
+     * Backs the dynamic storage of all the arrays above and the ones nested
+     * within call frames, none of which outlive the execution context.
+     * Objects and namespace nodes are never allocated from here as they are
+     * reference counted and may escape (e.g. via the return value or by
+     * being stored into a global).
+     */
+    struct uacpi_arena arena;
+
+    // Non-NULL if this context belongs to the execution context pool
+    struct execution_context_slot *pool_slot;
+
     struct call_frame *cur_frame;
     struct code_block *cur_block;
     const struct uacpi_op_spec *cur_op;
@@ -329,8 +346,35 @@ struct execution_context {
 
     uacpi_bool skip_else;
     uacpi_u8 sync_level;
+
+    /*
+     * Set if this context is executing with only the namespace read lock
+     * held, see uacpi_execute_control_method_shared().
+     */
+    uacpi_bool shared;
+    uacpi_bool needs_exclusive_access;
+
+    /*
+     * Set if the result of this invocation depends on something other than
+     * the AML and the namespace, e.g. Timer or _OSI. Such results must never
+     * be memoized by the eval cache.
+     */
+    uacpi_bool result_is_volatile;
 };
 
+/*
+ * Called right before an operation that would modify state visible outside of
+ * the current execution context (the namespace, named objects, hardware, host
+ * callbacks etc.) during shared execution. Nothing has been modified at this
+ * point, so the whole invocation is aborted and restarted by the caller with
+ * the namespace write lock held.
+ */
+static uacpi_status require_exclusive_access(struct execution_context *ctx)
+{
+    ctx->needs_exclusive_access = UACPI_TRUE;
+    return UACPI_STATUS_DENIED;
+}
+
 #define AML_READ(ptr, offset) (*(((uacpi_u8*)(ptr)) + offset))
 
 static uacpi_status parse_nameseg(uacpi_u8 *cursor,
@@ -358,59 +402,66 @@ static uacpi_status parse_nameseg(uacpi_u8 *cursor,
  * MultiNamePath := MultiNamePrefix SegCount NameSeg(SegCount)
  */
 
-static uacpi_status name_string_to_path(
-    struct call_frame *frame, uacpi_size offset,
-    uacpi_char **out_string, uacpi_size *out_size
+struct aml_name_string {
+    // Either a single RootChar or zero or more ParentPrefixChars
+    uacpi_u8 *prefix;
+    uacpi_u32 prefix_bytes;
+
+    uacpi_u8 *segments;
+    uacpi_u32 segment_count;
+
+    // A plain NameSeg without a prefix, subject to the upward search rules
+    uacpi_bool is_single_nameseg;
+
+    uacpi_u32 end_offset;
+};
+
+/*
+ * Splits the NameString at 'offset' into its components without validating
+ * the individual NameSegs or allocating anything.
+ */
+static uacpi_status decode_name_string(
+    struct call_frame *frame, uacpi_size offset, struct aml_name_string *out
 )
 {
-    uacpi_size bytes_left, prefix_bytes, nameseg_bytes = 0, namesegs;
-    uacpi_char *base_cursor, *cursor;
-    uacpi_char prev_char;
+    uacpi_size bytes_left;
+    uacpi_u8 *cursor;
 
     bytes_left = frame->method->size - offset;
-    cursor = (uacpi_char*)frame->method->code + offset;
-    base_cursor = cursor;
-    namesegs = 0;
+    cursor = frame->method->code + offset;
 
-    prefix_bytes = 0;
-    for (;;) {
-        if (uacpi_unlikely(bytes_left == 0))
-            return UACPI_STATUS_AML_INVALID_NAMESTRING;
-
-        prev_char = *cursor;
+    out->prefix = cursor;
+    out->prefix_bytes = 0;
+    out->is_single_nameseg = UACPI_FALSE;
 
-        switch (prev_char) {
-        case '^':
-        case '\\':
-            prefix_bytes++;
+    if (bytes_left != 0 && *cursor == '\\') {
+        out->prefix_bytes++;
+        cursor++;
+        bytes_left--;
+    } else {
+        while (bytes_left != 0 && *cursor == '^') {
+            out->prefix_bytes++;
             cursor++;
             bytes_left--;
-            break;
-        default:
-            break;
         }
-
-        if (prev_char != '^')
-            break;
     }
 
     // At least a NullName byte is expected here
     if (uacpi_unlikely(bytes_left == 0))
         return UACPI_STATUS_AML_INVALID_NAMESTRING;
 
-    namesegs = 0;
     bytes_left--;
     switch (*cursor++)
     {
     case UACPI_DUAL_NAME_PREFIX:
-        namesegs = 2;
+        out->segment_count = 2;
         break;
     case UACPI_MULTI_NAME_PREFIX:
         if (uacpi_unlikely(bytes_left == 0))
             return UACPI_STATUS_AML_INVALID_NAMESTRING;
 
-        namesegs = *(uacpi_u8*)cursor;
-        if (uacpi_unlikely(namesegs == 0)) {
+        out->segment_count = *cursor;
+        if (uacpi_unlikely(out->segment_count == 0)) {
             uacpi_error("MultiNamePrefix but SegCount is 0\n");
             return UACPI_STATUS_AML_INVALID_NAMESTRING;
         }
@@ -419,21 +470,46 @@ static uacpi_status name_string_to_path(
         bytes_left--;
         break;
     case UACPI_NULL_NAME:
+        out->segment_count = 0;
         break;
     default:
         /*
          * Might be an invalid byte, but assume single nameseg for now,
-         * the code below will validate it for us.
+         * the caller will validate it.
          */
         cursor--;
         bytes_left++;
-        namesegs = 1;
+        out->segment_count = 1;
+        out->is_single_nameseg = out->prefix_bytes == 0;
         break;
     }
 
-    if (uacpi_unlikely((namesegs * 4) > bytes_left))
+    if (uacpi_unlikely((out->segment_count * 4) > bytes_left))
         return UACPI_STATUS_AML_INVALID_NAMESTRING;
 
+    out->segments = cursor;
+    out->end_offset = cursor - frame->method->code;
+    out->end_offset += out->segment_count * 4;
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status name_string_to_path(
+    struct call_frame *frame, uacpi_size offset,
+    uacpi_char **out_string, uacpi_size *out_size
+)
+{
+    uacpi_status ret;
+    struct aml_name_string str;
+    uacpi_size nameseg_bytes = 0;
+    uacpi_u32 namesegs;
+    uacpi_u8 *cursor;
+    uacpi_char *out_cursor;
+
+    ret = decode_name_string(frame, offset, &str);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    namesegs = str.segment_count;
     if (namesegs) {
         // 4 chars per nameseg
         nameseg_bytes = namesegs * 4;
@@ -442,27 +518,28 @@ static uacpi_status name_string_to_path(
         nameseg_bytes += namesegs - 1;
     }
 
-    *out_size = nameseg_bytes + prefix_bytes + 1;
+    *out_size = nameseg_bytes + str.prefix_bytes + 1;
 
     *out_string = uacpi_kernel_alloc(*out_size);
     if (*out_string == UACPI_NULL)
         return UACPI_STATUS_OUT_OF_MEMORY;
 
-    uacpi_memcpy(*out_string, base_cursor, prefix_bytes);
+    uacpi_memcpy(*out_string, str.prefix, str.prefix_bytes);
 
-    base_cursor = *out_string;
-    base_cursor += prefix_bytes;
+    out_cursor = *out_string;
+    out_cursor += str.prefix_bytes;
+    cursor = str.segments;
 
     while (namesegs-- > 0) {
-        uacpi_memcpy(base_cursor, cursor, 4);
+        uacpi_memcpy(out_cursor, cursor, 4);
         cursor += 4;
-        base_cursor += 4;
+        out_cursor += 4;
 
         if (namesegs)
-            *base_cursor++ = '.';
+            *out_cursor++ = '.';
     }
 
-    *base_cursor = '\0';
+    *out_cursor = '\0';
     return UACPI_STATUS_OK;
 }
 
@@ -471,107 +548,50 @@ enum resolve_behavior {
     RESOLVE_FAIL_IF_DOESNT_EXIST,
 };
 
-static uacpi_status resolve_name_string(
+/*
+ * Resolves the NameString at the current code offset by walking its AML
+ * encoding directly against the namespace tree.
+ */
+static uacpi_status do_resolve_name_string(
     struct call_frame *frame,
     enum resolve_behavior behavior,
     struct uacpi_namespace_node **out_node
 )
 {
     uacpi_status ret = UACPI_STATUS_OK;
+    struct aml_name_string str;
     uacpi_u8 *cursor;
-    uacpi_size bytes_left, namesegs = 0;
+    uacpi_u32 i, namesegs;
     struct uacpi_namespace_node *parent, *cur_node = frame->cur_scope;
-    uacpi_char prev_char = 0;
-    uacpi_bool just_one_nameseg = UACPI_TRUE;
-
-    bytes_left = call_frame_code_bytes_left(frame);
-    cursor = call_frame_cursor(frame);
-
-    for (;;) {
-        if (uacpi_unlikely(bytes_left == 0))
-            return UACPI_STATUS_AML_INVALID_NAMESTRING;
 
-        switch (*cursor) {
-        case '\\':
-            if (prev_char == '^')
-                return UACPI_STATUS_AML_INVALID_NAMESTRING;
+    ret = decode_name_string(frame, frame->code_offset, &str);
+    if (uacpi_unlikely_error(ret))
+        return ret;
 
+    for (i = 0; i < str.prefix_bytes; ++i) {
+        if (str.prefix[i] == '\\') {
             cur_node = uacpi_namespace_root();
-            break;
-        case '^':
-            // Tried to go behind root
-            if (uacpi_unlikely(cur_node == uacpi_namespace_root()))
-                return UACPI_STATUS_AML_INVALID_NAMESTRING;
-
-            cur_node = cur_node->parent;
-            break;
-        default:
-            break;
-        }
-
-        prev_char = *cursor;
-
-        switch (prev_char) {
-        case '^':
-        case '\\':
-            just_one_nameseg = UACPI_FALSE;
-            cursor++;
-            bytes_left--;
-            break;
-        default:
-            break;
+            continue;
         }
 
-        if (prev_char != '^')
-            break;
-    }
-
-    // At least a NullName byte is expected here
-    if (uacpi_unlikely(bytes_left == 0))
-        return UACPI_STATUS_AML_INVALID_NAMESTRING;
-
-    bytes_left--;
-    switch (*cursor++)
-    {
-    case UACPI_DUAL_NAME_PREFIX:
-        namesegs = 2;
-        just_one_nameseg = UACPI_FALSE;
-        break;
-    case UACPI_MULTI_NAME_PREFIX:
-        if (uacpi_unlikely(bytes_left == 0))
+        // Tried to go behind root
+        if (uacpi_unlikely(cur_node == uacpi_namespace_root()))
             return UACPI_STATUS_AML_INVALID_NAMESTRING;
 
-        namesegs = *cursor;
-        if (uacpi_unlikely(namesegs == 0)) {
-            uacpi_error("MultiNamePrefix but SegCount is 0\n");
-            return UACPI_STATUS_AML_INVALID_NAMESTRING;
-        }
+        cur_node = cur_node->parent;
+    }
 
-        cursor++;
-        bytes_left--;
-        just_one_nameseg = UACPI_FALSE;
-        break;
-    case UACPI_NULL_NAME:
+    if (str.segment_count == 0) {
         if (behavior == RESOLVE_CREATE_LAST_NAMESEG_FAIL_IF_EXISTS ||
-            just_one_nameseg)
+            str.prefix_bytes == 0)
             return UACPI_STATUS_AML_INVALID_NAMESTRING;
 
         goto out;
-    default:
-        /*
-         * Might be an invalid byte, but assume single nameseg for now,
-         * the code below will validate it for us.
-         */
-        cursor--;
-        bytes_left++;
-        namesegs = 1;
-        break;
     }
 
-    if (uacpi_unlikely((namesegs * 4) > bytes_left))
-        return UACPI_STATUS_AML_INVALID_NAMESTRING;
+    cursor = str.segments;
 
-    for (; namesegs; cursor += 4, namesegs--) {
+    for (namesegs = str.segment_count; namesegs; cursor += 4, namesegs--) {
         uacpi_object_name name;
 
         ret = parse_nameseg(cursor, &name);
@@ -596,7 +616,7 @@ static uacpi_status resolve_name_string(
             }
             break;
         case RESOLVE_FAIL_IF_DOESNT_EXIST:
-            if (just_one_nameseg) {
+            if (str.is_single_nameseg) {
                 while (!cur_node && parent != uacpi_namespace_root()) {
                     cur_node = parent;
                     parent = cur_node->parent;
@@ -616,8 +636,7 @@ static uacpi_status resolve_name_string(
     }
 
 out:
-    cursor += namesegs * 4;
-    frame->code_offset = cursor - frame->method->code;
+    frame->code_offset = str.end_offset;
 
     if (uacpi_likely_success(ret) && behavior == RESOLVE_FAIL_IF_DOESNT_EXIST)
         uacpi_shareable_ref(cur_node);
@@ -626,9 +645,117 @@ out:
     return ret;
 }
 
-static uacpi_status do_install_node_item(struct call_frame *frame,
+/*
+ * Name cache entries are shared by all concurrent (shared) executions of a
+ * method, and are thus protected by a sequence counter: it's odd while an
+ * entry is being written, and bumped again once the write is complete. An
+ * entry that is being written or changes while being read is simply a cache
+ * miss, and a writer that loses the race for an entry doesn't cache anything.
+ *
+ * All fields are accessed atomically so that the loads of the fields can't be
+ * reordered past the second load of the sequence counter.
+ */
+static uacpi_bool name_cache_lookup(
+    uacpi_cached_name *entry, struct call_frame *frame, uacpi_u64 generation,
+    uacpi_namespace_node **out_node
+)
+{
+    uacpi_namespace_node *node, *scope;
+    uacpi_u64 entry_generation, name_generation;
+    uacpi_u32 seq, offset, end_offset;
+
+    seq = uacpi_atomic_load32(&entry->seq);
+    if (seq & 1)
+        return UACPI_FALSE;
+
+    node = (uacpi_namespace_node*)uacpi_atomic_load_ptr(&entry->node);
+    scope = (uacpi_namespace_node*)uacpi_atomic_load_ptr(&entry->scope);
+    entry_generation = uacpi_atomic_load64(&entry->generation);
+    name_generation = uacpi_atomic_load64(&entry->name_generation);
+    offset = uacpi_atomic_load32(&entry->offset);
+    end_offset = uacpi_atomic_load32(&entry->end_offset);
+
+    if (uacpi_atomic_load32(&entry->seq) != seq)
+        return UACPI_FALSE;
+
+    // The generation must be checked first, as it guards the node pointer
+    if (node == UACPI_NULL || offset != frame->code_offset ||
+        scope != frame->cur_scope || entry_generation != generation ||
+        name_generation != uacpi_namespace_name_generation(node->name))
+        return UACPI_FALSE;
+
+    frame->code_offset = end_offset;
+    uacpi_shareable_ref(node);
+    *out_node = node;
+    return UACPI_TRUE;
+}
+
+static void name_cache_store(
+    uacpi_cached_name *entry, struct call_frame *frame, uacpi_u32 offset,
+    uacpi_u64 generation, uacpi_namespace_node *node
+)
+{
+    uacpi_u32 seq;
+
+    seq = uacpi_atomic_load32(&entry->seq);
+    if ((seq & 1) || !uacpi_atomic_cmpxchg32(&entry->seq, &seq, seq + 1))
+        return;
+
+    uacpi_atomic_store_ptr(&entry->scope, frame->cur_scope);
+    uacpi_atomic_store_ptr(&entry->node, node);
+    uacpi_atomic_store64(&entry->generation, generation);
+    uacpi_atomic_store64(
+        &entry->name_generation, uacpi_namespace_name_generation(node->name)
+    );
+    uacpi_atomic_store32(&entry->offset, offset);
+    uacpi_atomic_store32(&entry->end_offset, frame->code_offset);
+
+    uacpi_atomic_store32(&entry->seq, seq + 2);
+}
+
+static uacpi_status resolve_name_string(
+    struct call_frame *frame,
+    enum resolve_behavior behavior,
+    struct uacpi_namespace_node **out_node
+)
+{
+    uacpi_status ret;
+    uacpi_cached_name *cache, *entry;
+    uacpi_u32 offset = frame->code_offset;
+    uacpi_u64 generation;
+
+    cache = (uacpi_cached_name*)uacpi_atomic_load_ptr(
+        &frame->method->name_cache
+    );
+    if (cache == UACPI_NULL || behavior != RESOLVE_FAIL_IF_DOESNT_EXIST)
+        return do_resolve_name_string(frame, behavior, out_node);
+
+    generation = uacpi_namespace_generation();
+    entry = &cache[offset & (UACPI_NAME_CACHE_SIZE - 1)];
+
+    if (name_cache_lookup(entry, frame, generation, out_node))
+        return UACPI_STATUS_OK;
+
+    ret = do_resolve_name_string(frame, behavior, out_node);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    /*
+     * Temporary nodes don't invalidate the cache when they go away, so
+     * neither they nor anything looked up relative to them may be cached.
+     */
+    if (uacpi_namespace_node_is_temporary(*out_node) ||
+        uacpi_namespace_node_is_temporary(frame->cur_scope))
+        return ret;
+
+    name_cache_store(entry, frame, offset, generation, *out_node);
+    return ret;
+}
+
+static uacpi_status do_install_node_item(struct execution_context *ctx,
                                          struct item *item)
 {
+    struct call_frame *frame = ctx->cur_frame;
     uacpi_status ret;
 
     ret = uacpi_namespace_node_install(item->node->parent, item->node);
@@ -636,7 +763,9 @@ static uacpi_status do_install_node_item(struct call_frame *frame,
         return ret;
 
     if (!frame->method->named_objects_persist)
-        ret = temp_namespace_node_array_push(&frame->temp_nodes, item->node);
+        ret = temp_namespace_node_array_push(
+            &frame->temp_nodes, &ctx->arena, item->node
+        );
 
     if (uacpi_likely_success(ret))
         item->node = UACPI_NULL;
@@ -644,16 +773,123 @@ static uacpi_status do_install_node_item(struct call_frame *frame,
     return ret;
 }
 
+/*
+ * Decode cache entries are laid out as follows:
+ * - bits 31-30: entry kind, zero means the offset hasn't been decoded yet
+ * For DECODE_ENTRY_OP:
+ * - bits 15-0: the full (possibly extended) opcode at this offset
+ * For DECODE_ENTRY_PKGLEN:
+ * - bits 29-28: PkgLength marker length minus one
+ * - bits 27-0: the decoded package length
+ *
+ * Since an offset may be interpreted differently depending on the state of
+ * the namespace (e.g. method call argument counts), a lookup only counts as
+ * a hit if the entry kind matches, otherwise we fall back to decoding the raw
+ * AML and leave the existing entry alone.
+ */
+#define DECODE_ENTRY_KIND_MASK (3u << 30)
+#define DECODE_ENTRY_OP (1u << 30)
+#define DECODE_ENTRY_PKGLEN (2u << 30)
+#define DECODE_ENTRY_PKGLEN_MARKER_SHIFT 28
+#define DECODE_ENTRY_PKGLEN_SIZE_MASK ((1u << 28) - 1)
+
+static void method_maybe_enable_caches(uacpi_control_method *method)
+{
+#if UACPI_DECODE_CACHE_CALL_THRESHOLD == 0
+    UACPI_UNUSED(method);
+#else
+    void *cache;
+
+    if (method->native_call || method->named_objects_persist ||
+        method->size == 0 ||
+        uacpi_atomic_load32(&method->call_count) >=
+            UACPI_DECODE_CACHE_CALL_THRESHOLD)
+        return;
+
+    /*
+     * Shared executions of the same method may get here concurrently, only
+     * the one that crosses the threshold allocates the caches. They are
+     * published atomically, as other executions may already be running.
+     */
+    if (uacpi_atomic_inc32(&method->call_count) !=
+            UACPI_DECODE_CACHE_CALL_THRESHOLD)
+        return;
+
+    /*
+     * Failing to allocate either cache is not fatal, the method will simply
+     * keep being decoded and resolved from raw AML.
+     */
+#ifdef UACPI_DECODE_CACHE
+    cache = uacpi_kernel_alloc_zeroed(
+        method->size * sizeof(*method->decode_cache)
+    );
+    if (cache != UACPI_NULL)
+        uacpi_atomic_store_ptr(&method->decode_cache, cache);
+#endif
+
+    if (UACPI_NAME_CACHE_SIZE != 0) {
+        cache = uacpi_kernel_alloc_zeroed(
+            UACPI_NAME_CACHE_SIZE * sizeof(*method->name_cache)
+        );
+        if (cache != UACPI_NULL)
+            uacpi_atomic_store_ptr(&method->name_cache, cache);
+    }
+#endif
+}
+
+static uacpi_u32 *call_frame_decode_entry(struct call_frame *frame)
+{
+#ifdef UACPI_DECODE_CACHE
+    uacpi_u32 *cache;
+
+    cache = (uacpi_u32*)uacpi_atomic_load_ptr(&frame->method->decode_cache);
+    if (cache == UACPI_NULL)
+        return UACPI_NULL;
+
+    return &cache[frame->code_offset];
+#else
+    UACPI_UNUSED(frame);
+    return UACPI_NULL;
+#endif
+}
+
+/*
+ * Every decode cache entry is written at most once, by whichever execution
+ * decodes the offset first, so concurrent shared executions of a method may
+ * all populate it.
+ */
+static void decode_entry_publish(uacpi_u32 *entry, uacpi_u32 value)
+{
+    uacpi_u32 expected = 0;
+
+    uacpi_atomic_cmpxchg32(entry, &expected, value);
+}
+
 static uacpi_status get_op(struct execution_context *ctx)
 {
     uacpi_aml_op op;
     struct call_frame *frame = ctx->cur_frame;
     void *code = frame->method->code;
     uacpi_size size = frame->method->size;
+    uacpi_u32 *entry, cached = 0;
 
     if (uacpi_unlikely(frame->code_offset >= size))
         return UACPI_STATUS_AML_BAD_ENCODING;
 
+    entry = call_frame_decode_entry(frame);
+    if (entry != UACPI_NULL)
+        cached = uacpi_atomic_load32(entry);
+
+    if ((cached & DECODE_ENTRY_KIND_MASK) == DECODE_ENTRY_OP) {
+        op = cached & 0xFFFF;
+        frame->code_offset += op > 0xFF ? 2 : 1;
+
+        if (!ctx->shared)
+            g_uacpi_rt_ctx.opcodes_executed++;
+        ctx->cur_op = uacpi_get_op_spec(op);
+        return UACPI_STATUS_OK;
+    }
+
     op = AML_READ(code, frame->code_offset++);
     if (op == UACPI_EXT_PREFIX) {
         if (uacpi_unlikely(frame->code_offset >= size))
@@ -663,7 +899,8 @@ static uacpi_status get_op(struct execution_context *ctx)
         op |= AML_READ(code, frame->code_offset++);
     }
 
-    g_uacpi_rt_ctx.opcodes_executed++;
+    if (!ctx->shared)
+        g_uacpi_rt_ctx.opcodes_executed++;
 
     ctx->cur_op = uacpi_get_op_spec(op);
     if (uacpi_unlikely(ctx->cur_op->properties & UACPI_OP_PROPERTY_RESERVED)) {
@@ -674,6 +911,9 @@ static uacpi_status get_op(struct execution_context *ctx)
         return UACPI_STATUS_AML_INVALID_OPCODE;
     }
 
+    if (entry != UACPI_NULL && cached == 0)
+        decode_entry_publish(entry, DECODE_ENTRY_OP | op);
+
     return UACPI_STATUS_OK;
 }
 
@@ -1270,8 +1510,10 @@ static uacpi_status do_load_table(
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    if (is_dynamic_table_load(cause))
+    if (is_dynamic_table_load(cause)) {
+        uacpi_utilities_invalidate_caches();
         uacpi_events_match_post_dynamic_table_load();
+    }
 
     return ret;
 }
@@ -1315,6 +1557,7 @@ static uacpi_status handle_load_table(struct execution_context *ctx)
             return UACPI_STATUS_OK;
         }
 
+        uacpi_utilities_invalidate_caches();
         uacpi_events_match_post_dynamic_table_load();
         return UACPI_STATUS_OK;
     }
@@ -1406,8 +1649,10 @@ static uacpi_status handle_load(struct execution_context *ctx)
      * We do this only if table load was successful though.
      */
     if (item_array_size(items) == 5) {
-        if (item_array_at(items, 4)->obj->integer != 0)
+        if (item_array_at(items, 4)->obj->integer != 0) {
+            uacpi_utilities_invalidate_caches();
             uacpi_events_match_post_dynamic_table_load();
+        }
         return UACPI_STATUS_OK;
     }
 
@@ -1770,7 +2015,7 @@ static uacpi_status handle_create_field(struct execution_context *ctx)
             if (uacpi_unlikely(node->object == UACPI_NULL))
                 return UACPI_STATUS_OUT_OF_MEMORY;
 
-            ret = do_install_node_item(ctx->cur_frame, item);
+            ret = do_install_node_item(ctx, item);
             if (uacpi_unlikely_error(ret))
                 return ret;
 
@@ -1946,7 +2191,7 @@ static uacpi_status begin_block_execution(struct execution_context *ctx)
     struct package_length *pkg;
     struct code_block *block;
 
-    block = code_block_array_alloc(&cur_frame->code_blocks);
+    block = code_block_array_alloc(&cur_frame->code_blocks, &ctx->arena);
     if (uacpi_unlikely(block == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
@@ -3111,6 +3356,7 @@ static uacpi_status handle_timer(struct execution_context *ctx)
 
     dst = item_array_at(&op_ctx->items, 0)->obj;
     dst->integer = uacpi_kernel_get_nanoseconds_since_boot() / 100;
+    ctx->result_is_volatile = UACPI_TRUE;
 
     return UACPI_STATUS_OK;
 }
@@ -3373,7 +3619,7 @@ static uacpi_status handle_match(struct execution_context *ctx)
 static uacpi_status parse_package_length(struct call_frame *frame,
                                          struct package_length *out_pkg)
 {
-    uacpi_u32 left, size;
+    uacpi_u32 left, size, *entry, cached = 0;
     uacpi_u8 *data, marker_length;
 
     out_pkg->begin = frame->code_offset;
@@ -3383,6 +3629,16 @@ static uacpi_status parse_package_length(struct call_frame *frame,
     if (uacpi_unlikely(left < 1))
         return UACPI_STATUS_AML_BAD_ENCODING;
 
+    entry = call_frame_decode_entry(frame);
+    if (entry != UACPI_NULL)
+        cached = uacpi_atomic_load32(entry);
+
+    if ((cached & DECODE_ENTRY_KIND_MASK) == DECODE_ENTRY_PKGLEN) {
+        marker_length += (cached >> DECODE_ENTRY_PKGLEN_MARKER_SHIFT) & 3;
+        size = cached & DECODE_ENTRY_PKGLEN_SIZE_MASK;
+        goto out;
+    }
+
     data = call_frame_cursor(frame);
     marker_length += *data >> 6;
 
@@ -3407,6 +3663,14 @@ static uacpi_status parse_package_length(struct call_frame *frame,
     }
     }
 
+    if (entry != UACPI_NULL && cached == 0) {
+        decode_entry_publish(
+            entry, DECODE_ENTRY_PKGLEN | size |
+                   ((marker_length - 1) << DECODE_ENTRY_PKGLEN_MARKER_SHIFT)
+        );
+    }
+
+out:
     frame->code_offset += marker_length;
 
     out_pkg->end = out_pkg->begin + size;
@@ -3616,7 +3880,9 @@ static uacpi_status handle_mutex_ctl(struct execution_context *ctx)
         if (uacpi_unlikely_error(ret))
             break;
 
-        ret = held_mutexes_array_push(&ctx->held_mutexes, obj->mutex);
+        ret = held_mutexes_array_push(
+            &ctx->held_mutexes, &ctx->arena, obj->mutex
+        );
         if (uacpi_unlikely_error(ret)) {
             uacpi_release_aml_mutex(obj->mutex);
             return ret;
@@ -4114,13 +4380,14 @@ static uacpi_status frame_push_args(struct call_frame *frame,
     return UACPI_STATUS_OK;
 }
 
-static uacpi_status frame_setup_base_scope(struct call_frame *frame,
+static uacpi_status frame_setup_base_scope(struct execution_context *ctx,
+                                           struct call_frame *frame,
                                            uacpi_namespace_node *scope,
                                            uacpi_control_method *method)
 {
     struct code_block *block;
 
-    block = code_block_array_alloc(&frame->code_blocks);
+    block = code_block_array_alloc(&frame->code_blocks, &ctx->arena);
     if (uacpi_unlikely(block == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
@@ -4139,7 +4406,7 @@ static uacpi_status push_new_frame(struct execution_context *ctx,
     struct call_frame_array *call_stack = &ctx->call_stack;
     struct call_frame *prev_frame;
 
-    *out_frame = call_frame_array_calloc(call_stack);
+    *out_frame = call_frame_array_calloc(call_stack, &ctx->arena);
     if (uacpi_unlikely(*out_frame == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
@@ -4210,6 +4477,28 @@ static uacpi_status store_to_target(uacpi_object *dst, uacpi_object *src)
     return ret;
 }
 
+/*
+ * Whether storing to 'dst' only affects the current call frame, as opposed to
+ * a named object or something referenced by a local or an argument.
+ */
+static uacpi_bool target_is_frame_local(uacpi_object *dst)
+{
+    switch (dst->type) {
+    case UACPI_OBJECT_INTEGER:
+        // NULL target
+        return dst->integer == 0;
+    case UACPI_OBJECT_REFERENCE:
+        if (dst->flags != UACPI_REFERENCE_KIND_LOCAL &&
+            dst->flags != UACPI_REFERENCE_KIND_ARG)
+            return UACPI_FALSE;
+
+        dst = uacpi_unwrap_internal_reference(dst);
+        return dst->type != UACPI_OBJECT_REFERENCE;
+    default:
+        return UACPI_FALSE;
+    }
+}
+
 static uacpi_status handle_copy_object_or_store(struct execution_context *ctx)
 {
     uacpi_object *src, *dst;
@@ -4305,7 +4594,12 @@ static uacpi_status enter_method(
 {
     uacpi_status ret = UACPI_STATUS_OK;
 
+    if (ctx->shared &&
+        (method->is_serialized || method->needs_exclusive_execution))
+        return require_exclusive_access(ctx);
+
     uacpi_shareable_ref(method);
+    method_maybe_enable_caches(method);
 
     if (!method->is_serialized)
         return ret;
@@ -4331,7 +4625,9 @@ static uacpi_status enter_method(
         if (uacpi_unlikely_error(ret))
             return ret;
 
-        ret = held_mutexes_array_push(&ctx->held_mutexes, method->mutex);
+        ret = held_mutexes_array_push(
+            &ctx->held_mutexes, &ctx->arena, method->mutex
+        );
         if (uacpi_unlikely_error(ret)) {
             uacpi_release_aml_mutex(method->mutex);
             return ret;
@@ -4348,7 +4644,7 @@ static uacpi_status push_op(struct execution_context *ctx)
     struct call_frame *frame = ctx->cur_frame;
     struct op_context *op_ctx;
 
-    op_ctx = op_context_array_calloc(&frame->pending_ops);
+    op_ctx = op_context_array_calloc(&frame->pending_ops, &ctx->arena);
     if (op_ctx == UACPI_NULL)
         return UACPI_STATUS_OUT_OF_MEMORY;
 
@@ -4383,16 +4679,17 @@ static void pop_op(struct execution_context *ctx)
 
     while (pop_item(cur_op_ctx));
 
-    item_array_clear(&cur_op_ctx->items);
+    item_array_clear(&cur_op_ctx->items, &ctx->arena);
     op_context_array_pop(&frame->pending_ops);
     refresh_ctx_pointers(ctx);
 }
 
-static void call_frame_clear(struct call_frame *frame)
+static void call_frame_clear(struct execution_context *ctx,
+                             struct call_frame *frame)
 {
     uacpi_size i;
-    op_context_array_clear(&frame->pending_ops);
-    code_block_array_clear(&frame->code_blocks);
+    op_context_array_clear(&frame->pending_ops, &ctx->arena);
+    code_block_array_clear(&frame->code_blocks, &ctx->arena);
 
     while (temp_namespace_node_array_size(&frame->temp_nodes) != 0) {
         uacpi_namespace_node *node;
@@ -4401,7 +4698,7 @@ static void call_frame_clear(struct call_frame *frame)
         uacpi_namespace_node_uninstall(node);
         temp_namespace_node_array_pop(&frame->temp_nodes);
     }
-    temp_namespace_node_array_clear(&frame->temp_nodes);
+    temp_namespace_node_array_clear(&frame->temp_nodes, &ctx->arena);
 
     for (i = 0; i < 7; ++i)
         uacpi_object_unref(frame->args[i]);
@@ -4663,6 +4960,10 @@ static void trace_named_object_lookup_or_creation_failure(
     uacpi_size length;
     uacpi_bool is_create;
 
+    // Don't bother building the path strings if nobody is going to see them
+    if (!uacpi_should_log(level))
+        return;
+
     is_create = op == UACPI_PARSE_OP_CREATE_NAMESTRING ||
                 op == UACPI_PARSE_OP_CREATE_NAMESTRING_OR_NULL_IF_LOAD;
 
@@ -4775,6 +5076,72 @@ enum op_handler {
     OP_HANDLER_FIRMWARE_REQUEST,
 };
 
+/*
+ * Whether invoking the handler for the current op is guaranteed to only
+ * modify state private to the execution context, which is a requirement for
+ * running it during shared execution.
+ */
+static uacpi_bool op_handler_is_side_effect_free(
+    struct execution_context *ctx, enum op_handler handler
+)
+{
+    struct op_context *op_ctx = ctx->cur_op_ctx;
+    uacpi_object *obj;
+
+    switch (handler) {
+    case OP_HANDLER_LOCAL:
+    case OP_HANDLER_ARG:
+    case OP_HANDLER_STRING:
+    case OP_HANDLER_BINARY_MATH:
+    case OP_HANDLER_CONTROL_FLOW:
+    case OP_HANDLER_CODE_BLOCK:
+    case OP_HANDLER_RETURN:
+    case OP_HANDLER_REF_OR_DEREF_OF:
+    case OP_HANDLER_LOGICAL_NOT:
+    case OP_HANDLER_BINARY_LOGIC:
+    case OP_HANDLER_NAMED_OBJECT:
+    case OP_HANDLER_BUFFER:
+    case OP_HANDLER_PACKAGE:
+    case OP_HANDLER_CONCATENATE:
+    case OP_HANDLER_CONCATENATE_RES:
+    case OP_HANDLER_SIZEOF:
+    case OP_HANDLER_UNARY_MATH:
+    case OP_HANDLER_INDEX:
+    case OP_HANDLER_OBJECT_TYPE:
+    case OP_HANDLER_TO:
+    case OP_HANDLER_TO_STRING:
+    case OP_HANDLER_TIMER:
+    case OP_HANDLER_MID:
+    case OP_HANDLER_MATCH:
+    case OP_HANDLER_BCD:
+        return UACPI_TRUE;
+
+    case OP_HANDLER_COPY_OBJECT_OR_STORE:
+        obj = item_array_at(&op_ctx->items, 1)->obj;
+        return target_is_frame_local(obj);
+
+    case OP_HANDLER_INC_DEC:
+        // The result is stored back via the target, only check the read here
+        obj = item_array_at(&op_ctx->items, 0)->obj;
+        if (obj->type == UACPI_OBJECT_REFERENCE)
+            obj = reference_unwind(obj)->inner_object;
+
+        return obj->type != UACPI_OBJECT_FIELD_UNIT;
+
+    case OP_HANDLER_READ_FIELD: {
+        uacpi_namespace_node *node;
+
+        // Buffer fields are plain memory, field units go through opregions
+        node = item_array_at(&op_ctx->items, 0)->node;
+        obj = uacpi_namespace_node_get_object(node);
+        return obj->type == UACPI_OBJECT_BUFFER_FIELD;
+    }
+
+    default:
+        return UACPI_FALSE;
+    }
+}
+
 static uacpi_status (*op_handlers[])(struct execution_context *ctx) = {
     /*
      * All OPs that don't have a handler dispatch to here if
@@ -5030,7 +5397,7 @@ static uacpi_status prepare_method_call(
             goto method_dispatch_error;
     }
 
-    ret = frame_setup_base_scope(frame, node, method);
+    ret = frame_setup_base_scope(ctx, frame, node, method);
     if (uacpi_unlikely_error(ret))
         goto method_dispatch_error;
 
@@ -5052,7 +5419,7 @@ static uacpi_status prepare_method_call(
     return UACPI_STATUS_OK;
 
 method_dispatch_error:
-    call_frame_clear(frame);
+    call_frame_clear(ctx, frame);
     call_frame_array_pop(&ctx->call_stack);
     return ret;
 }
@@ -5103,7 +5470,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
         trace_pop(op);
 
         if (parse_op_generates_item[op] != ITEM_NONE) {
-            item = item_array_alloc(&op_ctx->items);
+            item = item_array_alloc(&op_ctx->items, &ctx->arena);
             if (uacpi_unlikely(item == UACPI_NULL))
                 return UACPI_STATUS_OUT_OF_MEMORY;
 
@@ -5337,6 +5704,12 @@ static uacpi_status exec_op(struct execution_context *ctx)
             else
                 behavior = RESOLVE_FAIL_IF_DOESNT_EXIST;
 
+            // Creating named objects always requires exclusive access
+            if (behavior != RESOLVE_FAIL_IF_DOESNT_EXIST && ctx->shared) {
+                ret = require_exclusive_access(ctx);
+                break;
+            }
+
             ret = resolve_name_string(frame, behavior, &item->node);
 
             if (ret == UACPI_STATUS_NOT_FOUND) {
@@ -5395,13 +5768,18 @@ static uacpi_status exec_op(struct execution_context *ctx)
             else
                 idx = handler_idx_of_ext_op[EXT_OP_IDX(code)];
 
+            if (ctx->shared && !op_handler_is_side_effect_free(ctx, idx)) {
+                ret = require_exclusive_access(ctx);
+                break;
+            }
+
             ret = op_handlers[idx](ctx);
             break;
         }
 
         case UACPI_PARSE_OP_INSTALL_NAMESPACE_NODE:
             item = item_array_at(&op_ctx->items, op_decode_byte(op_ctx));
-            ret = do_install_node_item(frame, item);
+            ret = do_install_node_item(ctx, item);
             break;
 
         case UACPI_PARSE_OP_OBJECT_TRANSFER_TO_PREV:
@@ -5481,6 +5859,11 @@ static uacpi_status exec_op(struct execution_context *ctx)
                 src = item->obj;
             }
 
+            if (ctx->shared && !target_is_frame_local(dst)) {
+                ret = require_exclusive_access(ctx);
+                break;
+            }
+
             ret = store_to_target(dst, src);
             break;
         }
@@ -5617,7 +6000,7 @@ static void ctx_reload_post_ret(struct execution_context *ctx)
         ctx->sync_level = ctx->cur_frame->prev_sync_level;
     }
 
-    call_frame_clear(ctx->cur_frame);
+    call_frame_clear(ctx, ctx->cur_frame);
     call_frame_array_pop(&ctx->call_stack);
 
     ctx->cur_frame = call_frame_array_last(&ctx->call_stack);
@@ -5685,6 +6068,316 @@ static void stack_unwind(struct execution_context *ctx)
     }
 }
 
+/*
+ * Shared execution was aborted because exclusive access is required, nothing
+ * went wrong as far as the AML is concerned so just drop all frames without
+ * reporting anything.
+ */
+static void stack_unwind_silently(struct execution_context *ctx)
+{
+    while (ctx->cur_frame != UACPI_NULL) {
+        while (op_context_array_size(&ctx->cur_frame->pending_ops) != 0)
+            pop_op(ctx);
+
+        ctx_reload_post_ret(ctx);
+    }
+}
+
+#if UACPI_EXECUTION_CONTEXT_POOL_SIZE != 0
+struct execution_context_slot {
+    uacpi_u32 in_use;
+    struct execution_context *ctx;
+};
+
+/*
+ * Contexts in the pool are allocated lazily and then kept around for reuse,
+ * along with their arena, until uacpi_deinitialize_interpreter(). Slots are
+ * claimed with a single compare-exchange so that concurrent evaluations don't
+ * have to serialize on a lock just to get a context.
+ */
+static struct execution_context_slot
+execution_context_pool[UACPI_EXECUTION_CONTEXT_POOL_SIZE];
+#endif
+
+static struct execution_context *execution_context_alloc(void)
+{
+#if UACPI_EXECUTION_CONTEXT_POOL_SIZE != 0
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_ARRAY_SIZE(execution_context_pool); ++i) {
+        struct execution_context_slot *slot = &execution_context_pool[i];
+        uacpi_u32 expected = 0;
+
+        if (!uacpi_atomic_cmpxchg32(&slot->in_use, &expected, 1))
+            continue;
+
+        if (slot->ctx == UACPI_NULL) {
+            slot->ctx = uacpi_kernel_alloc_zeroed(sizeof(*slot->ctx));
+            if (uacpi_unlikely(slot->ctx == UACPI_NULL)) {
+                uacpi_atomic_store32(&slot->in_use, 0);
+                return UACPI_NULL;
+            }
+
+            slot->ctx->pool_slot = slot;
+        }
+
+        return slot->ctx;
+    }
+#endif
+
+    return uacpi_kernel_alloc_zeroed(sizeof(struct execution_context));
+}
+
+static void execution_context_free(struct execution_context *ctx)
+{
+#if UACPI_EXECUTION_CONTEXT_POOL_SIZE != 0
+    struct execution_context_slot *slot = ctx->pool_slot;
+
+    if (slot != UACPI_NULL) {
+        /*
+         * Both arrays have already been emptied by execution_context_release()
+         * and call frames are zeroed as they are pushed, so only the scalar
+         * state has to be reset instead of the entire context.
+         */
+        uacpi_arena_reset(&ctx->arena);
+        ctx->ret = UACPI_NULL;
+        ctx->cur_frame = UACPI_NULL;
+        ctx->cur_block = UACPI_NULL;
+        ctx->cur_op = UACPI_NULL;
+        ctx->prev_op_ctx = UACPI_NULL;
+        ctx->cur_op_ctx = UACPI_NULL;
+        ctx->skip_else = UACPI_FALSE;
+        ctx->sync_level = 0;
+        ctx->shared = UACPI_FALSE;
+        ctx->needs_exclusive_access = UACPI_FALSE;
+        ctx->result_is_volatile = UACPI_FALSE;
+
+        uacpi_atomic_store32(&slot->in_use, 0);
+        return;
+    }
+#endif
+
+    uacpi_arena_deinit(&ctx->arena);
+    uacpi_free(ctx, sizeof(*ctx));
+}
+
+#if UACPI_EVAL_CACHE_SIZE != 0
+/*
+ * A direct-mapped cache of results of argument-less methods that completed
+ * under shared execution, see UACPI_EVAL_CACHE_SIZE. All entries are guarded
+ * by a single kernel spinlock that is only held for a few loads and stores,
+ * objects are always created and destroyed outside of it.
+ *
+ * Cached results are never handed out directly, every hit produces a deep
+ * copy, as the caller is free to modify the returned object.
+ */
+struct eval_cache_entry {
+    uacpi_u64 epoch;
+    uacpi_namespace_node *node;
+    uacpi_control_method *method;
+    uacpi_object *result;
+};
+
+static struct eval_cache_entry eval_cache[UACPI_EVAL_CACHE_SIZE];
+static uacpi_handle eval_cache_lock;
+
+/*
+ * Entries tagged with any other epoch are stale. This is bumped on every
+ * namespace write unlock, so it has to be wide enough to never wrap.
+ */
+static uacpi_u64 eval_cache_epoch;
+
+// Results nested deeper than this are not worth the recursion
+#define EVAL_CACHE_MAX_PACKAGE_DEPTH 4
+
+static struct eval_cache_entry *eval_cache_entry_lock(
+    uacpi_control_method *method, uacpi_cpu_flags *out_flags
+)
+{
+    uacpi_u32 hash;
+
+    if (uacpi_unlikely(eval_cache_lock == UACPI_NULL))
+        return UACPI_NULL;
+
+    hash = (uacpi_u32)((uacpi_uintptr)method >> 4) * 0x9E3779B1;
+    hash ^= hash >> 16;
+
+    *out_flags = uacpi_kernel_lock_spinlock(eval_cache_lock);
+    return &eval_cache[hash & (UACPI_EVAL_CACHE_SIZE - 1)];
+}
+
+static void eval_cache_entry_unlock(uacpi_cpu_flags flags)
+{
+    uacpi_kernel_unlock_spinlock(eval_cache_lock, flags);
+}
+
+static uacpi_bool eval_cache_object_is_cacheable(
+    uacpi_object *obj, uacpi_u32 depth
+)
+{
+    uacpi_size i;
+
+    switch (obj->type) {
+    case UACPI_OBJECT_INTEGER:
+    case UACPI_OBJECT_STRING:
+    case UACPI_OBJECT_BUFFER:
+        return UACPI_TRUE;
+    case UACPI_OBJECT_PACKAGE:
+        if (depth == EVAL_CACHE_MAX_PACKAGE_DEPTH)
+            return UACPI_FALSE;
+
+        for (i = 0; i < obj->package->count; ++i) {
+            if (!eval_cache_object_is_cacheable(obj->package->objects[i],
+                                                depth + 1))
+                return UACPI_FALSE;
+        }
+
+        return UACPI_TRUE;
+    default:
+        // References, fields etc. are tied to the state of the namespace
+        return UACPI_FALSE;
+    }
+}
+
+static uacpi_object *eval_cache_copy_object(uacpi_object *src)
+{
+    uacpi_object *dst;
+
+    dst = uacpi_create_object(UACPI_OBJECT_UNINITIALIZED);
+    if (uacpi_unlikely(dst == UACPI_NULL))
+        return UACPI_NULL;
+
+    if (uacpi_unlikely_error(uacpi_object_assign(
+            dst, src, UACPI_ASSIGN_BEHAVIOR_DEEP_COPY))) {
+        uacpi_object_unref(dst);
+        return UACPI_NULL;
+    }
+
+    return dst;
+}
+
+static uacpi_bool eval_cache_lookup(
+    uacpi_namespace_node *node, uacpi_control_method *method,
+    uacpi_u64 epoch, uacpi_object **out_obj
+)
+{
+    struct eval_cache_entry *entry;
+    uacpi_object *cached = UACPI_NULL;
+    uacpi_cpu_flags flags;
+
+    entry = eval_cache_entry_lock(method, &flags);
+    if (entry == UACPI_NULL)
+        return UACPI_FALSE;
+
+    if (entry->result != UACPI_NULL && entry->epoch == epoch &&
+        entry->node == node && entry->method == method) {
+        cached = entry->result;
+        uacpi_object_ref(cached);
+    }
+    eval_cache_entry_unlock(flags);
+
+    if (cached == UACPI_NULL)
+        return UACPI_FALSE;
+
+    *out_obj = eval_cache_copy_object(cached);
+    uacpi_object_unref(cached);
+
+    return *out_obj != UACPI_NULL;
+}
+
+static void eval_cache_store(
+    uacpi_namespace_node *node, uacpi_control_method *method,
+    uacpi_u64 epoch, uacpi_object *result
+)
+{
+    struct eval_cache_entry *entry;
+    uacpi_object *copy, *old;
+    uacpi_cpu_flags flags;
+
+    if (!eval_cache_object_is_cacheable(result, 0))
+        return;
+
+    copy = eval_cache_copy_object(result);
+    if (uacpi_unlikely(copy == UACPI_NULL))
+        return;
+
+    entry = eval_cache_entry_lock(method, &flags);
+    if (uacpi_unlikely(entry == UACPI_NULL)) {
+        uacpi_object_unref(copy);
+        return;
+    }
+
+    old = entry->result;
+    entry->epoch = epoch;
+    entry->node = node;
+    entry->method = method;
+    entry->result = copy;
+    eval_cache_entry_unlock(flags);
+
+    if (old != UACPI_NULL)
+        uacpi_object_unref(old);
+}
+
+static void eval_cache_deinit(void)
+{
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_ARRAY_SIZE(eval_cache); ++i) {
+        struct eval_cache_entry *entry = &eval_cache[i];
+
+        if (entry->result != UACPI_NULL)
+            uacpi_object_unref(entry->result);
+
+        uacpi_memzero(entry, sizeof(*entry));
+    }
+
+    if (eval_cache_lock != UACPI_NULL) {
+        uacpi_kernel_free_spinlock(eval_cache_lock);
+        eval_cache_lock = UACPI_NULL;
+    }
+}
+#endif
+
+void uacpi_eval_cache_invalidate(void)
+{
+#if UACPI_EVAL_CACHE_SIZE != 0
+    uacpi_atomic_inc64(&eval_cache_epoch);
+#endif
+}
+
+uacpi_status uacpi_initialize_interpreter(void)
+{
+#if UACPI_EVAL_CACHE_SIZE != 0
+    eval_cache_lock = uacpi_kernel_create_spinlock();
+    if (uacpi_unlikely(eval_cache_lock == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+#endif
+
+    return UACPI_STATUS_OK;
+}
+
+void uacpi_deinitialize_interpreter(void)
+{
+#if UACPI_EXECUTION_CONTEXT_POOL_SIZE != 0
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_ARRAY_SIZE(execution_context_pool); ++i) {
+        struct execution_context_slot *slot = &execution_context_pool[i];
+
+        if (slot->ctx == UACPI_NULL)
+            continue;
+
+        uacpi_arena_deinit(&slot->ctx->arena);
+        uacpi_free(slot->ctx, sizeof(*slot->ctx));
+        slot->ctx = UACPI_NULL;
+    }
+#endif
+
+#if UACPI_EVAL_CACHE_SIZE != 0
+    eval_cache_deinit();
+#endif
+}
+
 static void execution_context_release(struct execution_context *ctx)
 {
     if (ctx->ret)
@@ -5698,23 +6391,42 @@ static void execution_context_release(struct execution_context *ctx)
         );
     }
 
-    call_frame_array_clear(&ctx->call_stack);
-    held_mutexes_array_clear(&ctx->held_mutexes);
-    uacpi_free(ctx, sizeof(*ctx));
+    call_frame_array_clear(&ctx->call_stack, &ctx->arena);
+    held_mutexes_array_clear(&ctx->held_mutexes, &ctx->arena);
+    execution_context_free(ctx);
 }
 
-uacpi_status uacpi_execute_control_method(
+static uacpi_status execute_control_method(
     uacpi_namespace_node *scope, uacpi_control_method *method,
-    const uacpi_object_array *args, uacpi_object **out_obj
+    const uacpi_object_array *args, uacpi_object **out_obj,
+    uacpi_bool shared
 )
 {
     uacpi_status ret = UACPI_STATUS_OK;
     struct execution_context *ctx;
+#if UACPI_EVAL_CACHE_SIZE != 0
+    uacpi_bool cacheable;
+    uacpi_u64 epoch = 0;
 
-    ctx = uacpi_kernel_alloc_zeroed(sizeof(*ctx));
+    /*
+     * Only shared execution can prove a method to be side-effect free, as it
+     * would have been aborted otherwise.
+     */
+    cacheable = shared && out_obj != UACPI_NULL && !method->native_call &&
+                method->args == 0 && (args == UACPI_NULL || args->count == 0);
+    if (cacheable) {
+        epoch = uacpi_atomic_load64(&eval_cache_epoch);
+        if (eval_cache_lookup(scope, method, epoch, out_obj))
+            return UACPI_STATUS_OK;
+    }
+#endif
+
+    ctx = execution_context_alloc();
     if (uacpi_unlikely(ctx == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
+    ctx->shared = shared;
+
     if (out_obj != UACPI_NULL) {
         ctx->ret = uacpi_create_object(UACPI_OBJECT_UNINITIALIZED);
         if (uacpi_unlikely(ctx->ret == UACPI_NULL)) {
@@ -5755,6 +6467,11 @@ uacpi_status uacpi_execute_control_method(
         continue;
 
     handle_method_abort:
+        if (ctx->needs_exclusive_access) {
+            stack_unwind_silently(ctx);
+            goto out;
+        }
+
         uacpi_error("aborting %s due to previous error: %s\n",
                     ctx->cur_frame->method->named_objects_persist ?
                         "table load" : "method invocation",
@@ -5776,7 +6493,7 @@ uacpi_status uacpi_execute_control_method(
     }
 
 out:
-    if (ctx->ret != UACPI_NULL) {
+    if (ctx->ret != UACPI_NULL && !ctx->needs_exclusive_access) {
         uacpi_object *ret_obj = UACPI_NULL;
 
         if (ctx->ret->type != UACPI_OBJECT_UNINITIALIZED) {
@@ -5785,12 +6502,34 @@ out:
         }
 
         *out_obj = ret_obj;
+
+#if UACPI_EVAL_CACHE_SIZE != 0
+        if (cacheable && ret == UACPI_STATUS_OK && ret_obj != UACPI_NULL &&
+            !ctx->result_is_volatile)
+            eval_cache_store(scope, method, epoch, ret_obj);
+#endif
     }
 
     execution_context_release(ctx);
     return ret;
 }
 
+uacpi_status uacpi_execute_control_method(
+    uacpi_namespace_node *scope, uacpi_control_method *method,
+    const uacpi_object_array *args, uacpi_object **out_obj
+)
+{
+    return execute_control_method(scope, method, args, out_obj, UACPI_FALSE);
+}
+
+uacpi_status uacpi_execute_control_method_shared(
+    uacpi_namespace_node *scope, uacpi_control_method *method,
+    const uacpi_object_array *args, uacpi_object **out_obj
+)
+{
+    return execute_control_method(scope, method, args, out_obj, UACPI_TRUE);
+}
+
 uacpi_status uacpi_osi(uacpi_handle handle, uacpi_object *retval)
 {
     struct execution_context *ctx = handle;
@@ -5808,6 +6547,8 @@ uacpi_status uacpi_osi(uacpi_handle handle, uacpi_object *retval)
     if (retval == UACPI_NULL)
         return UACPI_STATUS_OK;
 
+    // The set of supported interfaces can be changed by the host at any time
+    ctx->result_is_volatile = UACPI_TRUE;
     retval->type = UACPI_OBJECT_INTEGER;
 
     ret = uacpi_handle_osi(arg->buffer->text, &is_supported);
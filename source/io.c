@@ -43,52 +43,129 @@ static uacpi_size bit_span_offset(struct bit_span *span, uacpi_size bits)
     return delta;
 }
 
-static void bit_copy(struct bit_span *dst, struct bit_span *src)
+/*
+ * Little-endian loads & stores of 'count' <= 8 bytes. The full 8 byte case is
+ * written out so that compilers turn it into a single unaligned access.
+ */
+static uacpi_u64 load_bytes(const uacpi_u8 *ptr, uacpi_u8 count)
 {
-    uacpi_u8 src_shift, dst_shift, bits = 0;
-    uacpi_u16 dst_mask;
-    uacpi_u8 *dst_ptr, *src_ptr;
-    uacpi_u64 dst_count, src_count;
+    uacpi_u64 value = 0;
+    uacpi_u8 i;
+
+    if (count == 8) {
+        return (uacpi_u64)ptr[0]       | (uacpi_u64)ptr[1] << 8  |
+               (uacpi_u64)ptr[2] << 16 | (uacpi_u64)ptr[3] << 24 |
+               (uacpi_u64)ptr[4] << 32 | (uacpi_u64)ptr[5] << 40 |
+               (uacpi_u64)ptr[6] << 48 | (uacpi_u64)ptr[7] << 56;
+    }
 
-    dst_ptr = dst->data + (dst->index / 8);
-    src_ptr = src->data + (src->index / 8);
+    for (i = 0; i < count; ++i)
+        value |= (uacpi_u64)ptr[i] << (i * 8);
 
-    dst_count = dst->length;
-    dst_shift = dst->index & 7;
+    return value;
+}
 
-    src_count = src->length;
-    src_shift = src->index & 7;
+static void store_bytes(uacpi_u8 *ptr, uacpi_u64 value, uacpi_u8 count)
+{
+    uacpi_u8 i;
 
-    while (dst_count)
-    {
-        bits = 0;
+    if (count == 8) {
+        ptr[0] = value;       ptr[1] = value >> 8;
+        ptr[2] = value >> 16; ptr[3] = value >> 24;
+        ptr[4] = value >> 32; ptr[5] = value >> 40;
+        ptr[6] = value >> 48; ptr[7] = value >> 56;
+        return;
+    }
 
-        if (src_count) {
-            bits = *src_ptr >> src_shift;
+    for (i = 0; i < count; ++i)
+        ptr[i] = value >> (i * 8);
+}
 
-            if (src_shift && src_count > (uacpi_u32)(8 - src_shift))
-                bits |= *(src_ptr + 1) << (8 - src_shift);
+static uacpi_u64 low_bits_mask(uacpi_u8 count)
+{
+    return count >= 64 ? ~0ull : (1ull << count) - 1;
+}
 
-            if (src_count < 8) {
-                bits &= (1 << src_count) - 1;
-                src_count = 0;
-            } else {
-                src_count -= 8;
-                src_ptr++;
-            }
-        }
+/*
+ * Consume up to 'count' <= 64 bits from the span, zero-extending the result
+ * once the span runs out. Never touches bytes past the end of the span.
+ */
+static uacpi_u64 bit_span_load(struct bit_span *span, uacpi_u8 count)
+{
+    const uacpi_u8 *ptr;
+    uacpi_u8 shift, bytes;
+    uacpi_u64 value;
 
-        dst_mask = (dst_count < 8 ? (1 << dst_count) - 1 : 0xFF) << dst_shift;
-        *dst_ptr = (*dst_ptr & ~dst_mask) | ((bits << dst_shift) & dst_mask);
+    count = UACPI_MIN(span->length, count);
+    if (count == 0)
+        return 0;
 
-        if (dst_shift && dst_count > (uacpi_u32)(8 - dst_shift)) {
-            dst_mask >>= 8;
-            *(dst_ptr + 1) &= ~dst_mask;
-            *(dst_ptr + 1) |= (bits >> (8 - dst_shift)) & dst_mask;
-        }
+    ptr = span->const_data + (span->index / 8);
+    shift = span->index & 7;
+    bytes = (shift + count + 7) / 8;
+
+    value = load_bytes(ptr, UACPI_MIN(bytes, 8)) >> shift;
+    if (bytes > 8)
+        value |= (uacpi_u64)ptr[8] << (64 - shift);
+
+    bit_span_offset(span, count);
+    return value & low_bits_mask(count);
+}
+
+/*
+ * Overwrite the next 'count' <= 64 bits of the span with 'value', leaving all
+ * the bits around them intact.
+ */
+static void bit_span_store(
+    struct bit_span *span, uacpi_u64 value, uacpi_u8 count
+)
+{
+    uacpi_u8 *ptr;
+    uacpi_u8 shift, bytes, low_count;
+    uacpi_u64 mask, word;
+
+    ptr = span->data + (span->index / 8);
+    shift = span->index & 7;
+    bytes = (shift + count + 7) / 8;
+
+    if (shift == 0 && count == 64) {
+        store_bytes(ptr, value, 8);
+        goto out;
+    }
+
+    low_count = UACPI_MIN(count, 64 - shift);
+    mask = low_bits_mask(low_count) << shift;
+
+    word = load_bytes(ptr, UACPI_MIN(bytes, 8));
+    word = (word & ~mask) | ((value << shift) & mask);
+    store_bytes(ptr, word, UACPI_MIN(bytes, 8));
+
+    if (bytes > 8) {
+        mask = low_bits_mask(count - low_count);
+        ptr[8] = (ptr[8] & ~mask) | ((value >> low_count) & mask);
+    }
+
+out:
+    bit_span_offset(span, count);
+}
 
-        dst_count = dst_count > 8 ? dst_count - 8 : 0;
-        ++dst_ptr;
+/*
+ * Copy dst->length bits from 'src' to 'dst', zero-extending the source if it's
+ * shorter. This is done 64 bits at a time, with the first chunk sized so that
+ * all of the following stores start on a byte boundary.
+ */
+static void bit_copy(struct bit_span *dst, struct bit_span *src)
+{
+    struct bit_span dst_span = *dst, src_span = *src;
+    uacpi_u8 count;
+
+    count = 64 - (dst_span.index & 7);
+
+    while (dst_span.length) {
+        count = UACPI_MIN(dst_span.length, count);
+
+        bit_span_store(&dst_span, bit_span_load(&src_span, count), count);
+        count = 64;
     }
 }
 
@@ -174,13 +251,50 @@ void uacpi_write_buffer_field(
     do_write_misaligned_buffer_field(field, src, size);
 }
 
-static uacpi_status access_field_unit(
-    uacpi_field_unit *field, uacpi_u32 offset, uacpi_region_op op,
-    uacpi_u64 *in_out
+/*
+ * State of a single field unit read or write. The global lock, the opregion
+ * lock and the region attachment are taken once when the session begins,
+ * and then held for all of the accesses needed to transfer the field.
+ */
+struct field_session {
+    uacpi_field_unit *field;
+
+    // UACPI_FIELD_UNIT_KIND_NORMAL & UACPI_FIELD_UNIT_KIND_BANK
+    uacpi_namespace_node *region_node;
+    uacpi_object *region_obj;
+
+    /*
+     * UACPI_FIELD_UNIT_KIND_INDEX, NULL if the index & data fields are
+     * accessed via their own sessions on every access instead.
+     */
+    struct field_session *index;
+    struct field_session *data;
+};
+
+static void field_session_end(struct field_session *session);
+
+static uacpi_status read_field_unit(
+    struct field_session *session, void *dst, uacpi_size size
+);
+static uacpi_status write_field_unit(
+    struct field_session *session, const void *src, uacpi_size size
+);
+
+/*
+ * 'children' is storage for the sessions of the index & data fields of an
+ * index field, and may be NULL.
+ */
+static uacpi_status field_session_begin(
+    struct field_session *session, uacpi_field_unit *field,
+    struct field_session *children
 )
 {
     uacpi_status ret = UACPI_STATUS_OK;
-    uacpi_namespace_node *region_node;
+
+    session->field = field;
+    session->region_obj = UACPI_NULL;
+    session->index = UACPI_NULL;
+    session->data = UACPI_NULL;
 
     if (field->lock_rule) {
         ret = uacpi_acquire_aml_mutex(
@@ -195,61 +309,143 @@ static uacpi_status access_field_unit(
         ret = uacpi_write_field_unit(
             field->bank_selection, &field->bank_value, sizeof(field->bank_value)
         );
-        region_node = field->bank_region;
+        if (uacpi_unlikely_error(ret))
+            break;
+
+        session->region_node = field->bank_region;
+        ret = uacpi_opregion_io_begin(
+            session->region_node, &session->region_obj
+        );
         break;
     case UACPI_FIELD_UNIT_KIND_NORMAL:
-        region_node = field->region;
+        session->region_node = field->region;
+        ret = uacpi_opregion_io_begin(
+            session->region_node, &session->region_obj
+        );
         break;
     case UACPI_FIELD_UNIT_KIND_INDEX:
-        ret = uacpi_write_field_unit(
-            field->index, &offset, sizeof(offset)
-        );
-        if (uacpi_unlikely_error(ret))
-            goto out;
-
-        switch (op) {
-        case UACPI_REGION_OP_READ:
-            ret = uacpi_read_field_unit(
-                field->data, in_out, field->access_width_bytes
-            );
+        if (children == UACPI_NULL)
             break;
-        case UACPI_REGION_OP_WRITE:
-            ret = uacpi_write_field_unit(
-                field->data, in_out, field->access_width_bytes
-            );
+
+        ret = field_session_begin(&children[0], field->index, UACPI_NULL);
+        if (uacpi_unlikely_error(ret))
             break;
-        default:
-            ret = UACPI_STATUS_INVALID_ARGUMENT;
+
+        ret = field_session_begin(&children[1], field->data, UACPI_NULL);
+        if (uacpi_unlikely_error(ret)) {
+            field_session_end(&children[0]);
             break;
         }
 
-        goto out;
-
+        session->index = &children[0];
+        session->data = &children[1];
+        break;
     default:
         uacpi_error("invalid field unit kind %d\n", field->kind);
         ret = UACPI_STATUS_INVALID_ARGUMENT;
     }
 
-    if (uacpi_unlikely_error(ret))
-        goto out;
+    if (uacpi_unlikely_error(ret) && field->lock_rule)
+        uacpi_release_aml_mutex(g_uacpi_rt_ctx.global_lock_mutex);
+    return ret;
+}
 
-    ret = uacpi_dispatch_opregion_io(
-        region_node, offset, field->access_width_bytes, op, in_out
-    );
+static void field_session_end(struct field_session *session)
+{
+    if (session->region_obj != UACPI_NULL)
+        uacpi_opregion_io_end(session->region_obj);
 
-out:
-    if (field->lock_rule)
+    if (session->index != UACPI_NULL) {
+        field_session_end(session->data);
+        field_session_end(session->index);
+    }
+
+    if (session->field->lock_rule)
         uacpi_release_aml_mutex(g_uacpi_rt_ctx.global_lock_mutex);
-    return ret;
+}
+
+static uacpi_status access_field_unit(
+    struct field_session *session, uacpi_u32 offset, uacpi_region_op op,
+    uacpi_u64 *in_out
+)
+{
+    uacpi_status ret;
+    uacpi_field_unit *field = session->field;
+
+    if (field->kind != UACPI_FIELD_UNIT_KIND_INDEX) {
+        return uacpi_opregion_io(
+            session->region_node, session->region_obj, offset,
+            field->access_width_bytes, op, in_out
+        );
+    }
+
+    if (session->index != UACPI_NULL)
+        ret = write_field_unit(session->index, &offset, sizeof(offset));
+    else
+        ret = uacpi_write_field_unit(field->index, &offset, sizeof(offset));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    switch (op) {
+    case UACPI_REGION_OP_READ:
+        if (session->data != UACPI_NULL) {
+            return read_field_unit(
+                session->data, in_out, field->access_width_bytes
+            );
+        }
+
+        return uacpi_read_field_unit(
+            field->data, in_out, field->access_width_bytes
+        );
+    case UACPI_REGION_OP_WRITE:
+        if (session->data != UACPI_NULL) {
+            return write_field_unit(
+                session->data, in_out, field->access_width_bytes
+            );
+        }
+
+        return uacpi_write_field_unit(
+            field->data, in_out, field->access_width_bytes
+        );
+    default:
+        return UACPI_STATUS_INVALID_ARGUMENT;
+    }
+}
+
+/*
+ * Transfers the entire field via a single block operation, which is only done
+ * for region fields that start & end on an access width boundary and span
+ * more than one access. UACPI_STATUS_UNIMPLEMENTED is returned without
+ * touching the field if that is not possible, in which case the caller falls
+ * back to per-access IO.
+ */
+static uacpi_status access_field_unit_block(
+    struct field_session *session, uacpi_region_op op, void *buffer
+)
+{
+    uacpi_field_unit *field = session->field;
+    uacpi_u32 width_access_bits = field->access_width_bytes * 8;
+
+    if (session->region_obj == UACPI_NULL ||
+        field->bit_offset_within_first_byte != 0 ||
+        field->bit_length <= width_access_bits ||
+        (field->bit_length % width_access_bits) != 0)
+        return UACPI_STATUS_UNIMPLEMENTED;
+
+    return uacpi_opregion_block_io(
+        session->region_node, session->region_obj, field->byte_offset,
+        field->access_width_bytes, op, buffer, field->bit_length / 8
+    );
 }
 
 static uacpi_status do_read_misaligned_field_unit(
-    uacpi_field_unit *field, uacpi_u8 *dst, uacpi_size size
+    struct field_session *session, uacpi_u8 *dst, uacpi_size size
 )
 {
     uacpi_status ret;
     uacpi_size reads_to_do;
     uacpi_u64 out;
+    uacpi_field_unit *field = session->field;
     uacpi_u32 byte_offset = field->byte_offset;
     uacpi_u32 bits_left = field->bit_length;
     uacpi_u8 width_access_bits = field->access_width_bytes * 8;
@@ -277,7 +473,7 @@ static uacpi_status do_read_misaligned_field_unit(
         );
 
         ret = access_field_unit(
-            field, byte_offset, UACPI_REGION_OP_READ,
+            session, byte_offset, UACPI_REGION_OP_READ,
             &out
         );
         if (uacpi_unlikely_error(ret))
@@ -294,11 +490,12 @@ static uacpi_status do_read_misaligned_field_unit(
     return UACPI_STATUS_OK;
 }
 
-uacpi_status uacpi_read_field_unit(
-    uacpi_field_unit *field, void *dst, uacpi_size size
+static uacpi_status read_field_unit(
+    struct field_session *session, void *dst, uacpi_size size
 )
 {
     uacpi_status ret;
+    uacpi_field_unit *field = session->field;
     uacpi_u32 field_byte_length;
 
     field_byte_length = uacpi_round_up_bits_to_bytes(field->bit_length);
@@ -315,7 +512,7 @@ uacpi_status uacpi_read_field_unit(
         uacpi_u64 out;
 
         ret = access_field_unit(
-            field, field->byte_offset, UACPI_REGION_OP_READ, &out
+            session, field->byte_offset, UACPI_REGION_OP_READ, &out
         );
         if (uacpi_unlikely_error(ret))
             return ret;
@@ -327,15 +524,49 @@ uacpi_status uacpi_read_field_unit(
         return UACPI_STATUS_OK;
     }
 
+    if (size >= field_byte_length) {
+        ret = access_field_unit_block(
+            session, UACPI_REGION_OP_READ_BLOCK, dst
+        );
+        if (ret != UACPI_STATUS_UNIMPLEMENTED) {
+            if (uacpi_likely_success(ret)) {
+                uacpi_memzero(
+                    (uacpi_u8*)dst + field_byte_length,
+                    size - field_byte_length
+                );
+            }
+
+            return ret;
+        }
+    }
+
     // Slow case
-    return do_read_misaligned_field_unit(field, dst, size);
+    return do_read_misaligned_field_unit(session, dst, size);
 }
 
-uacpi_status uacpi_write_field_unit(
-    uacpi_field_unit *field, const void *src, uacpi_size size
+uacpi_status uacpi_read_field_unit(
+    uacpi_field_unit *field, void *dst, uacpi_size size
 )
 {
     uacpi_status ret;
+    struct field_session session, children[2];
+
+    ret = field_session_begin(&session, field, children);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = read_field_unit(&session, dst, size);
+
+    field_session_end(&session);
+    return ret;
+}
+
+static uacpi_status write_field_unit(
+    struct field_session *session, const void *src, uacpi_size size
+)
+{
+    uacpi_status ret;
+    uacpi_field_unit *field = session->field;
     uacpi_u32 bits_left, byte_offset = field->byte_offset;
     uacpi_u8 width_access_bits = field->access_width_bytes * 8;
     uacpi_u64 in;
@@ -350,6 +581,15 @@ uacpi_status uacpi_write_field_unit(
         .index = field->bit_offset_within_first_byte,
     };
 
+    if (size * 8 >= field->bit_length) {
+        // Block handlers never write to the buffer for WRITE_BLOCK
+        ret = access_field_unit_block(
+            session, UACPI_REGION_OP_WRITE_BLOCK, (void*)src
+        );
+        if (ret != UACPI_STATUS_UNIMPLEMENTED)
+            return ret;
+    }
+
     bits_left = field->bit_length;
 
     while (bits_left) {
@@ -362,7 +602,7 @@ uacpi_status uacpi_write_field_unit(
             switch (field->update_rule) {
             case UACPI_UPDATE_RULE_PRESERVE:
                 ret = access_field_unit(
-                    field, byte_offset, UACPI_REGION_OP_READ, &in
+                    session, byte_offset, UACPI_REGION_OP_READ, &in
                 );
                 if (uacpi_unlikely_error(ret))
                     return ret;
@@ -383,7 +623,7 @@ uacpi_status uacpi_write_field_unit(
         bit_span_offset(&src_span, dst_span.length);
 
         ret = access_field_unit(
-            field, byte_offset, UACPI_REGION_OP_WRITE, &in
+            session, byte_offset, UACPI_REGION_OP_WRITE, &in
         );
         if (uacpi_unlikely_error(ret))
             return ret;
@@ -396,6 +636,23 @@ uacpi_status uacpi_write_field_unit(
     return UACPI_STATUS_OK;
 }
 
+uacpi_status uacpi_write_field_unit(
+    uacpi_field_unit *field, const void *src, uacpi_size size
+)
+{
+    uacpi_status ret;
+    struct field_session session, children[2];
+
+    ret = field_session_begin(&session, field, children);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = write_field_unit(&session, src, size);
+
+    field_session_end(&session);
+    return ret;
+}
+
 static uacpi_u8 gas_get_access_bit_width(const struct acpi_gas *gas)
 {
     /*
@@ -484,6 +741,106 @@ static uacpi_status gas_validate(
     return UACPI_STATUS_OK;
 }
 
+static uacpi_status gas_memory_read(
+    void *ptr, uacpi_size offset, uacpi_u8 width, uacpi_u64 *out
+)
+{
+    return uacpi_system_memory_read((uacpi_u8*)ptr + offset, width, out);
+}
+
+static uacpi_status gas_memory_write(
+    void *ptr, uacpi_size offset, uacpi_u8 width, uacpi_u64 in
+)
+{
+    return uacpi_system_memory_write((uacpi_u8*)ptr + offset, width, in);
+}
+
+static void gas_memory_unmap(void *ptr, uacpi_size size)
+{
+    uacpi_kernel_unmap(ptr, size);
+}
+
+static void gas_io_unmap(uacpi_handle handle, uacpi_size size)
+{
+    UACPI_UNUSED(size);
+    uacpi_kernel_io_unmap(handle);
+}
+
+uacpi_status uacpi_map_gas_noalloc(
+    const struct acpi_gas *gas, struct uacpi_mapped_gas *out_mapped
+)
+{
+    uacpi_status ret;
+    uacpi_u8 access_bit_width, total_width;
+
+    ret = gas_validate(gas, &access_bit_width);
+    if (ret != UACPI_STATUS_OK)
+        return ret;
+
+    total_width = UACPI_ALIGN_UP(
+        gas->register_bit_offset + gas->register_bit_width,
+        access_bit_width, uacpi_u8
+    );
+    out_mapped->size = total_width / 8;
+
+    if (gas->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_MEMORY) {
+        out_mapped->mapping = uacpi_kernel_map(gas->address, out_mapped->size);
+        if (uacpi_unlikely(out_mapped->mapping == UACPI_NULL))
+            return UACPI_STATUS_MAPPING_FAILED;
+
+        out_mapped->read = gas_memory_read;
+        out_mapped->write = gas_memory_write;
+        out_mapped->unmap = gas_memory_unmap;
+    } else { // UACPI_ADDRESS_SPACE_SYSTEM_IO
+        ret = uacpi_kernel_io_map(
+            gas->address, out_mapped->size, &out_mapped->mapping
+        );
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        out_mapped->read = uacpi_kernel_io_read;
+        out_mapped->write = uacpi_kernel_io_write;
+        out_mapped->unmap = gas_io_unmap;
+    }
+
+    out_mapped->access_bit_width = access_bit_width;
+    out_mapped->total_bit_width = total_width;
+    out_mapped->bit_offset = gas->register_bit_offset;
+    return UACPI_STATUS_OK;
+}
+
+void uacpi_unmap_gas_nofree(struct uacpi_mapped_gas *gas)
+{
+    gas->unmap(gas->mapping, gas->size);
+}
+
+uacpi_status uacpi_map_gas(
+    const struct acpi_gas *gas, uacpi_mapped_gas **out_mapped
+)
+{
+    uacpi_status ret;
+    uacpi_mapped_gas *mapping;
+
+    mapping = uacpi_kernel_alloc(sizeof(*mapping));
+    if (uacpi_unlikely(mapping == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    ret = uacpi_map_gas_noalloc(gas, mapping);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_free(mapping, sizeof(*mapping));
+        return ret;
+    }
+
+    *out_mapped = mapping;
+    return ret;
+}
+
+void uacpi_unmap_gas(uacpi_mapped_gas *gas)
+{
+    uacpi_unmap_gas_nofree(gas);
+    uacpi_free(gas, sizeof(*gas));
+}
+
 /*
  * Apparently both reading and writing GAS works differently from operation
  * region in that bit offsets are not respected when writing the data.
@@ -491,108 +848,111 @@ static uacpi_status gas_validate(
  * Let's follow ACPICA's approach here so that we don't accidentally
  * break any quirky hardware.
  */
-
-uacpi_status uacpi_gas_read(const struct acpi_gas *gas, uacpi_u64 *out_value)
+uacpi_status uacpi_gas_read_mapped(
+    const uacpi_mapped_gas *gas, uacpi_u64 *out_value
+)
 {
     uacpi_status ret;
-    uacpi_u8 access_bit_width, access_byte_width;
+    uacpi_u8 access_byte_width;
     uacpi_u8 bit_offset, bits_left, index = 0;
     uacpi_u64 data, mask = 0xFFFFFFFFFFFFFFFF;
+    uacpi_size offset = 0;
 
-    ret = gas_validate(gas, &access_bit_width);
-    if (ret != UACPI_STATUS_OK)
-        return ret;
-
-    bit_offset = gas->register_bit_offset;
-    bits_left = bit_offset + gas->register_bit_width;
+    bit_offset = gas->bit_offset;
+    bits_left = gas->total_bit_width;
 
-    access_byte_width = access_bit_width / 8;
+    access_byte_width = gas->access_bit_width / 8;
 
     if (access_byte_width < 8)
-        mask = ~(mask << access_bit_width);
+        mask = ~(mask << gas->access_bit_width);
 
     *out_value = 0;
 
     while (bits_left) {
-        if (bit_offset >= access_bit_width) {
+        if (bit_offset >= gas->access_bit_width) {
             data = 0;
-            bit_offset -= access_bit_width;
+            bit_offset -= gas->access_bit_width;
         } else {
-            uacpi_u64 address = gas->address + (index * access_byte_width);
-
-            if (gas->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_IO) {
-                ret = uacpi_system_io_read(address, access_byte_width, &data);
-            } else {
-                void *virt;
-
-                virt = uacpi_kernel_map(address, access_byte_width);
-                if (uacpi_unlikely(virt == UACPI_NULL))
-                    return UACPI_STATUS_MAPPING_FAILED;
-
-                ret = uacpi_system_memory_read(virt, access_byte_width, &data);
-                uacpi_kernel_unmap(virt, access_bit_width);
-            }
+            ret = gas->read(gas->mapping, offset, access_byte_width, &data);
             if (uacpi_unlikely_error(ret))
                 return ret;
         }
 
-        *out_value |= (data & mask) << (index * access_bit_width);
-        bits_left -= UACPI_MIN(bits_left, access_bit_width);
+        *out_value |= (data & mask) << (index * gas->access_bit_width);
+        bits_left -= UACPI_MIN(bits_left, gas->access_bit_width);
         ++index;
+        offset += access_byte_width;
     }
 
     return UACPI_STATUS_OK;
 }
 
-uacpi_status uacpi_gas_write(const struct acpi_gas *gas, uacpi_u64 in_value)
+uacpi_status uacpi_gas_write_mapped(
+    const uacpi_mapped_gas *gas, uacpi_u64 in_value
+)
 {
     uacpi_status ret;
-    uacpi_u8 access_bit_width, access_byte_width;
+    uacpi_u8 access_byte_width;
     uacpi_u8 bit_offset, bits_left, index = 0;
     uacpi_u64 data, mask = 0xFFFFFFFFFFFFFFFF;
+    uacpi_size offset = 0;
 
-    ret = gas_validate(gas, &access_bit_width);
-    if (ret != UACPI_STATUS_OK)
-        return ret;
-
-    bit_offset = gas->register_bit_offset;
-    bits_left = bit_offset + gas->register_bit_width;
-    access_byte_width = access_bit_width / 8;
+    bit_offset = gas->bit_offset;
+    bits_left = gas->total_bit_width;
+    access_byte_width = gas->access_bit_width / 8;
 
     if (access_byte_width < 8)
-        mask = ~(mask << access_bit_width);
+        mask = ~(mask << gas->access_bit_width);
 
     while (bits_left) {
-        data = (in_value >> (index * access_bit_width)) & mask;
+        data = (in_value >> (index * gas->access_bit_width)) & mask;
 
-        if (bit_offset >= access_bit_width) {
-            bit_offset -= access_bit_width;
+        if (bit_offset >= gas->access_bit_width) {
+            bit_offset -= gas->access_bit_width;
         } else {
-            uacpi_u64 address = gas->address + (index * access_byte_width);
-
-            if (gas->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_IO) {
-                ret = uacpi_system_io_write(address, access_byte_width, data);
-            } else {
-                void *virt;
-
-                virt = uacpi_kernel_map(address, access_byte_width);
-                if (uacpi_unlikely(virt == UACPI_NULL))
-                    return UACPI_STATUS_MAPPING_FAILED;
-
-                ret = uacpi_system_memory_write(virt, access_byte_width, data);
-                uacpi_kernel_unmap(virt, access_bit_width);
-            }
+            ret = gas->write(gas->mapping, offset, access_byte_width, data);
             if (uacpi_unlikely_error(ret))
                 return ret;
         }
 
-        bits_left -= UACPI_MIN(bits_left, access_bit_width);
+        bits_left -= UACPI_MIN(bits_left, gas->access_bit_width);
         ++index;
+        offset += access_byte_width;
     }
 
     return UACPI_STATUS_OK;
 }
 
+uacpi_status uacpi_gas_read(const struct acpi_gas *gas, uacpi_u64 *out_value)
+{
+    uacpi_status ret;
+    uacpi_mapped_gas mapping;
+
+    ret = uacpi_map_gas_noalloc(gas, &mapping);
+    if (ret != UACPI_STATUS_OK)
+        return ret;
+
+    ret = uacpi_gas_read_mapped(&mapping, out_value);
+    uacpi_unmap_gas_nofree(&mapping);
+
+    return ret;
+}
+
+uacpi_status uacpi_gas_write(const struct acpi_gas *gas, uacpi_u64 in_value)
+{
+    uacpi_status ret;
+    uacpi_mapped_gas mapping;
+
+    ret = uacpi_map_gas_noalloc(gas, &mapping);
+    if (ret != UACPI_STATUS_OK)
+        return ret;
+
+    ret = uacpi_gas_write_mapped(&mapping, in_value);
+    uacpi_unmap_gas_nofree(&mapping);
+
+    return ret;
+}
+
 uacpi_status uacpi_system_io_read(
     uacpi_io_addr address, uacpi_u8 width, uacpi_u64 *out
 )
@@ -670,3 +1030,44 @@ uacpi_status uacpi_system_memory_write(void *ptr, uacpi_u8 width, uacpi_u64 in)
 
     return UACPI_STATUS_OK;
 }
+
+uacpi_status uacpi_system_memory_read_block(
+    void *ptr, uacpi_u8 width, void *buf, uacpi_size length
+)
+{
+    uacpi_status ret;
+    uacpi_u8 *src = ptr, *dst = buf;
+    uacpi_u64 value;
+    uacpi_size i;
+
+    for (i = 0; i < length; i += width) {
+        ret = uacpi_system_memory_read(src + i, width, &value);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        uacpi_memcpy(dst + i, &value, width);
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+uacpi_status uacpi_system_memory_write_block(
+    void *ptr, uacpi_u8 width, const void *buf, uacpi_size length
+)
+{
+    uacpi_status ret;
+    uacpi_u8 *dst = ptr;
+    const uacpi_u8 *src = buf;
+    uacpi_u64 value = 0;
+    uacpi_size i;
+
+    for (i = 0; i < length; i += width) {
+        uacpi_memcpy(&value, src + i, width);
+
+        ret = uacpi_system_memory_write(dst + i, width, value);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+    }
+
+    return UACPI_STATUS_OK;
+}
@@ -311,82 +311,157 @@ uacpi_status uacpi_recursive_lock_release(struct uacpi_recursive_lock *lock)
     return uacpi_release_native_mutex(lock->mutex);
 }
 
+#define RW_LOCK_WRITER (1u << 31)
+#define RW_LOCK_READERS_MASK (RW_LOCK_WRITER - 1)
+
 uacpi_status uacpi_rw_lock_init(struct uacpi_rw_lock *lock)
 {
-    lock->read_mutex = uacpi_kernel_create_mutex();
-    if (uacpi_unlikely(lock->read_mutex == UACPI_NULL))
+    lock->write_mutex = uacpi_kernel_create_mutex();
+    if (uacpi_unlikely(lock->write_mutex == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
-    lock->write_mutex = uacpi_kernel_create_mutex();
-    if (uacpi_unlikely(lock->write_mutex == UACPI_NULL)) {
-        uacpi_kernel_free_mutex(lock->read_mutex);
-        lock->read_mutex = UACPI_NULL;
+    lock->readers_done_event = uacpi_kernel_create_event();
+    if (uacpi_unlikely(lock->readers_done_event == UACPI_NULL)) {
+        uacpi_kernel_free_mutex(lock->write_mutex);
+        lock->write_mutex = UACPI_NULL;
         return UACPI_STATUS_OUT_OF_MEMORY;
     }
 
-    lock->num_readers = 0;
+    lock->state = 0;
+    lock->read_contentions = 0;
+    lock->write_contentions = 0;
     return UACPI_STATUS_OK;
 }
 
 uacpi_status uacpi_rw_lock_deinit(struct uacpi_rw_lock *lock)
 {
-    if (uacpi_unlikely(lock->num_readers)) {
-        uacpi_warn("de-initializing rw_lock %p with %zu active readers\n",
-                   lock, lock->num_readers);
-        lock->num_readers = 0;
-    }
+    uacpi_u32 num_readers = lock->state & RW_LOCK_READERS_MASK;
 
-    if (lock->read_mutex != UACPI_NULL) {
-        uacpi_kernel_free_mutex(lock->read_mutex);
-        lock->read_mutex = UACPI_NULL;
+    if (uacpi_unlikely(num_readers)) {
+        uacpi_warn("de-initializing rw_lock %p with %u active readers\n",
+                   lock, num_readers);
     }
+    lock->state = 0;
+
     if (lock->write_mutex != UACPI_NULL) {
         uacpi_kernel_free_mutex(lock->write_mutex);
         lock->write_mutex = UACPI_NULL;
     }
+    if (lock->readers_done_event != UACPI_NULL) {
+        uacpi_kernel_free_event(lock->readers_done_event);
+        lock->readers_done_event = UACPI_NULL;
+    }
 
     return UACPI_STATUS_OK;
 }
 
+static uacpi_bool rw_lock_try_read(struct uacpi_rw_lock *lock)
+{
+    uacpi_u32 state = uacpi_atomic_load32(&lock->state);
+
+    while (!(state & RW_LOCK_WRITER)) {
+        if (uacpi_atomic_cmpxchg32(&lock->state, &state, state + 1))
+            return UACPI_TRUE;
+    }
+
+    return UACPI_FALSE;
+}
+
 uacpi_status uacpi_rw_lock_read(struct uacpi_rw_lock *lock)
 {
     uacpi_status ret;
 
-    ret = uacpi_acquire_native_mutex(lock->read_mutex);
+    if (uacpi_likely(rw_lock_try_read(lock)))
+        return UACPI_STATUS_OK;
+
+    uacpi_atomic_inc32(&lock->read_contentions);
+
+    /*
+     * A writer is either active or waiting for the current readers to leave,
+     * queue up behind it. RW_LOCK_WRITER is only ever set while holding the
+     * write mutex, so the reader count can be bumped unconditionally here.
+     */
+    ret = uacpi_acquire_native_mutex(lock->write_mutex);
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    if (lock->num_readers++ == 0) {
-        ret = uacpi_acquire_native_mutex(lock->write_mutex);
-        if (uacpi_unlikely_error(ret))
-            lock->num_readers = 0;
-    }
-
-    uacpi_kernel_release_mutex(lock->read_mutex);
+    uacpi_atomic_inc32(&lock->state);
+    uacpi_kernel_release_mutex(lock->write_mutex);
     return ret;
 }
 
 uacpi_status uacpi_rw_unlock_read(struct uacpi_rw_lock *lock)
+{
+    /*
+     * An unbalanced unlock would wrap the reader count, locking out writers
+     * forever. Catch it before the state is corrupted.
+     */
+    if (uacpi_unlikely(
+            (uacpi_atomic_load32(&lock->state) & RW_LOCK_READERS_MASK) == 0
+        )) {
+        uacpi_error("unbalanced read unlock of rw_lock %p\n", lock);
+        return UACPI_STATUS_INVALID_ARGUMENT;
+    }
+
+    // Last reader out, let the waiting writer in
+    if (uacpi_atomic_dec32(&lock->state) == RW_LOCK_WRITER)
+        uacpi_kernel_signal_event(lock->readers_done_event);
+
+    return UACPI_STATUS_OK;
+}
+
+uacpi_status uacpi_rw_lock_write(struct uacpi_rw_lock *lock)
 {
     uacpi_status ret;
+    uacpi_bool contended = UACPI_FALSE;
+    uacpi_u32 state, new_state;
+
+    if (uacpi_unlikely(lock->write_mutex == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
 
-    ret = uacpi_acquire_native_mutex(lock->read_mutex);
+    ret = uacpi_kernel_acquire_mutex(lock->write_mutex, 0);
+    if (ret == UACPI_STATUS_TIMEOUT) {
+        contended = UACPI_TRUE;
+        ret = uacpi_acquire_native_mutex(lock->write_mutex);
+    }
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    if (lock->num_readers-- == 1)
-        uacpi_release_native_mutex(lock->write_mutex);
+    // From this point on no new readers are let in
+    state = uacpi_atomic_load32(&lock->state);
+    do {
+        new_state = state | RW_LOCK_WRITER;
+    } while (!uacpi_atomic_cmpxchg32(&lock->state, &state, new_state));
+
+    /*
+     * The reader count can only go down now, and the reader that drops it to
+     * zero signals the event exactly once.
+     */
+    if (state & RW_LOCK_READERS_MASK) {
+        contended = UACPI_TRUE;
+
+        while (!uacpi_kernel_wait_for_event(lock->readers_done_event, 0xFFFF))
+            ;
+    }
+
+    if (contended)
+        uacpi_atomic_inc32(&lock->write_contentions);
 
-    uacpi_kernel_release_mutex(lock->read_mutex);
     return ret;
 }
 
-uacpi_status uacpi_rw_lock_write(struct uacpi_rw_lock *lock)
+uacpi_status uacpi_rw_unlock_write(struct uacpi_rw_lock *lock)
 {
-    return uacpi_acquire_native_mutex(lock->write_mutex);
+    uacpi_atomic_store32(&lock->state, 0);
+    return uacpi_release_native_mutex(lock->write_mutex);
 }
 
-uacpi_status uacpi_rw_unlock_write(struct uacpi_rw_lock *lock)
+void uacpi_rw_lock_get_stats(
+    struct uacpi_rw_lock *lock, uacpi_rw_lock_stats *out_stats
+)
 {
-    return uacpi_release_native_mutex(lock->write_mutex);
+    out_stats->read_contentions = uacpi_atomic_load32(&lock->read_contentions);
+    out_stats->write_contentions = uacpi_atomic_load32(
+        &lock->write_contentions
+    );
 }
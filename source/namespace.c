@@ -7,6 +7,7 @@
 #include <uacpi/internal/log.h>
 #include <uacpi/internal/utilities.h>
 #include <uacpi/internal/mutex.h>
+#include <uacpi/internal/pool.h>
 #include <uacpi/kernel_api.h>
 
 #define UACPI_REV_VALUE 2
@@ -34,6 +35,47 @@ predefined_namespaces[UACPI_PREDEFINED_NAMESPACE_MAX + 1] = {
 
 static struct uacpi_rw_lock namespace_lock;
 
+/*
+ * Bumped every time a permanent node is installed or uninstalled, so that
+ * cached name lookups can cheaply verify that they are still up to date.
+ */
+static uacpi_u64 namespace_generation;
+
+/*
+ * Temporary (method-local) nodes come and go on every call of a method that
+ * declares named objects, so they only bump the generation of their name's
+ * bucket instead. Installing a node can only change the result of an
+ * existing lookup by shadowing a node of the same name found via the upward
+ * search, and lookups that resolve to temporary nodes are never cached.
+ */
+#define NAME_GENERATION_BUCKETS 64
+static uacpi_u64 name_generations[NAME_GENERATION_BUCKETS];
+
+static uacpi_u64 *name_generation_slot(uacpi_object_name name)
+{
+    uacpi_u32 hash = name.id * 0x9E3779B1u;
+
+    return &name_generations[hash >> 26];
+}
+
+static void namespace_node_bump_generation(uacpi_namespace_node *node)
+{
+    if (node->flags & UACPI_NAMESPACE_NODE_FLAG_TEMPORARY)
+        (*name_generation_slot(node->name))++;
+    else
+        namespace_generation++;
+}
+
+uacpi_u64 uacpi_namespace_generation(void)
+{
+    return namespace_generation;
+}
+
+uacpi_u64 uacpi_namespace_name_generation(uacpi_object_name name)
+{
+    return *name_generation_slot(name);
+}
+
 uacpi_status uacpi_namespace_read_lock(void)
 {
     return uacpi_rw_lock_read(&namespace_lock);
@@ -51,9 +93,20 @@ uacpi_status uacpi_namespace_write_lock(void)
 
 uacpi_status uacpi_namespace_write_unlock(void)
 {
+    // Anything could have changed while we were holding the lock
+    uacpi_eval_cache_invalidate();
     return uacpi_rw_unlock_write(&namespace_lock);
 }
 
+uacpi_status uacpi_get_namespace_lock_stats(uacpi_rw_lock_stats *out_stats)
+{
+    if (uacpi_unlikely(out_stats == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    uacpi_rw_lock_get_stats(&namespace_lock, out_stats);
+    return UACPI_STATUS_OK;
+}
+
 static uacpi_object *make_object_for_predefined(
     enum uacpi_predefined_namespace ns
 )
@@ -138,12 +191,195 @@ static void namespace_node_detach_object(uacpi_namespace_node *node)
     }
 }
 
+#if UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD != 0
+/*
+ * An open-addressed, linearly probed hash table of a node's children keyed by
+ * name. If multiple children share the same name, only the one installed
+ * first is indexed, which matches the result of walking the child list.
+ */
+struct uacpi_namespace_child_index {
+    uacpi_u32 capacity;
+    uacpi_u32 count;
+    uacpi_namespace_node *slots[];
+};
+
+static uacpi_size child_index_size(uacpi_u32 capacity)
+{
+    return sizeof(struct uacpi_namespace_child_index) +
+           capacity * sizeof(uacpi_namespace_node*);
+}
+
+static uacpi_u32 child_index_hash(uacpi_object_name name)
+{
+    uacpi_u32 hash = name.id * 0x9E3779B1;
+
+    return hash ^ (hash >> 16);
+}
+
+static uacpi_namespace_node **child_index_find_slot(
+    struct uacpi_namespace_child_index *index, uacpi_object_name name
+)
+{
+    uacpi_u32 mask = index->capacity - 1;
+    uacpi_u32 i = child_index_hash(name) & mask;
+
+    // The load factor is always kept below 1/2, so this always terminates
+    while (index->slots[i] != UACPI_NULL &&
+           index->slots[i]->name.id != name.id)
+        i = (i + 1) & mask;
+
+    return &index->slots[i];
+}
+
+static void child_index_insert(
+    struct uacpi_namespace_child_index *index, uacpi_namespace_node *node
+)
+{
+    uacpi_namespace_node **slot;
+
+    slot = child_index_find_slot(index, node->name);
+    if (*slot != UACPI_NULL)
+        return;
+
+    *slot = node;
+    index->count++;
+}
+
+static void child_index_remove_slot(
+    struct uacpi_namespace_child_index *index, uacpi_namespace_node **slot
+)
+{
+    uacpi_u32 mask = index->capacity - 1;
+    uacpi_u32 i, j, k;
+
+    i = slot - index->slots;
+    j = i;
+
+    // Shift back the following entries of the cluster to fill the hole
+    for (;;) {
+        j = (j + 1) & mask;
+        if (index->slots[j] == UACPI_NULL)
+            break;
+
+        k = child_index_hash(index->slots[j]->name) & mask;
+
+        // The entry is already reachable without going through slot 'i'
+        if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+
+        index->slots[i] = index->slots[j];
+        i = j;
+    }
+
+    index->slots[i] = UACPI_NULL;
+    index->count--;
+}
+
+static void child_index_free(uacpi_namespace_node *node)
+{
+    struct uacpi_namespace_child_index *index = node->child_index;
+
+    if (index == UACPI_NULL)
+        return;
+
+    uacpi_free(index, child_index_size(index->capacity));
+    node->child_index = UACPI_NULL;
+}
+
+/*
+ * (Re)builds the index of 'node' from scratch. Failing to allocate the index
+ * is not fatal, lookups simply fall back to walking the child list.
+ */
+static void child_index_rebuild(uacpi_namespace_node *node, uacpi_u32 children)
+{
+    struct uacpi_namespace_child_index *index;
+    uacpi_namespace_node *child;
+    uacpi_u32 capacity = 16;
+
+    child_index_free(node);
+
+    // Start off at a load factor of at most 1/4
+    while (capacity < children * 4)
+        capacity *= 2;
+
+    index = uacpi_kernel_alloc_zeroed(child_index_size(capacity));
+    if (uacpi_unlikely(index == UACPI_NULL))
+        return;
+
+    index->capacity = capacity;
+
+    for (child = node->child; child != UACPI_NULL; child = child->next)
+        child_index_insert(index, child);
+
+    node->child_index = index;
+}
+
+static void child_index_on_install(
+    uacpi_namespace_node *parent, uacpi_namespace_node *node,
+    uacpi_u32 children
+)
+{
+    struct uacpi_namespace_child_index *index = parent->child_index;
+
+    if (index == UACPI_NULL) {
+        if (children >= UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD)
+            child_index_rebuild(parent, children);
+        return;
+    }
+
+    if ((index->count + 1) * 2 > index->capacity) {
+        child_index_rebuild(parent, children);
+        return;
+    }
+
+    child_index_insert(index, node);
+}
+
+static void child_index_on_uninstall(
+    uacpi_namespace_node *parent, uacpi_namespace_node *node
+)
+{
+    struct uacpi_namespace_child_index *index = parent->child_index;
+    uacpi_namespace_node **slot, *peer;
+
+    if (index == UACPI_NULL)
+        return;
+
+    slot = child_index_find_slot(index, node->name);
+
+    // This was a duplicate name that didn't get indexed
+    if (*slot != node)
+        return;
+
+    child_index_remove_slot(index, slot);
+
+    /*
+     * Any other child with the same name must have been installed later than
+     * this one, so it's somewhere after it in the list. It now becomes the
+     * visible node for this name.
+     */
+    for (peer = node->next; peer != UACPI_NULL; peer = peer->next) {
+        if (peer->name.id == node->name.id) {
+            child_index_insert(index, peer);
+            break;
+        }
+    }
+
+    if (index->count < UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD / 2)
+        child_index_free(parent);
+}
+#endif
+
 static void free_namespace_node(uacpi_handle handle)
 {
     uacpi_namespace_node *node = handle;
 
+#if UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD != 0
+    child_index_free(node);
+#endif
+
     if (uacpi_likely(!uacpi_namespace_node_is_predefined(node))) {
-        uacpi_free(node, sizeof(*node));
+        uacpi_pool_free(node, sizeof(*node));
         return;
     }
 
@@ -283,7 +519,7 @@ uacpi_namespace_node *uacpi_namespace_node_alloc(uacpi_object_name name)
 {
     uacpi_namespace_node *ret;
 
-    ret = uacpi_kernel_alloc_zeroed(sizeof(*ret));
+    ret = uacpi_pool_alloc_zeroed(sizeof(*ret));
     if (uacpi_unlikely(ret == UACPI_NULL))
         return ret;
 
@@ -302,6 +538,9 @@ uacpi_status uacpi_namespace_node_install(
     uacpi_namespace_node *node
 )
 {
+    // Including the node being installed
+    uacpi_u32 children = 1;
+
     if (parent == UACPI_NULL)
         parent = uacpi_namespace_root();
 
@@ -316,13 +555,23 @@ uacpi_status uacpi_namespace_node_install(
     } else {
         uacpi_namespace_node *prev = parent->child;
 
-        while (prev->next != UACPI_NULL)
+        children++;
+        while (prev->next != UACPI_NULL) {
             prev = prev->next;
+            children++;
+        }
 
         prev->next = node;
     }
 
     node->parent = parent;
+    namespace_node_bump_generation(node);
+
+#if UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD != 0
+    child_index_on_install(parent, node, children);
+#else
+    UACPI_UNUSED(children);
+#endif
     return UACPI_STATUS_OK;
 }
 
@@ -437,7 +686,12 @@ uacpi_status uacpi_namespace_node_uninstall(uacpi_namespace_node *node)
         prev->next = node->next;
     }
 
+#if UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD != 0
+    child_index_on_uninstall(node->parent, node);
+#endif
+
     node->flags |= UACPI_NAMESPACE_NODE_FLAG_DANGLING;
+    namespace_node_bump_generation(node);
     uacpi_namespace_node_unref(node);
 
     return UACPI_STATUS_OK;
@@ -451,6 +705,11 @@ uacpi_namespace_node *uacpi_namespace_node_find_sub_node(
     if (parent == UACPI_NULL)
         parent = uacpi_namespace_root();
 
+#if UACPI_NAMESPACE_CHILD_INDEX_THRESHOLD != 0
+    if (parent->child_index != UACPI_NULL)
+        return *child_index_find_slot(parent->child_index, name);
+#endif
+
     uacpi_namespace_node *node = parent->child;
 
     while (node) {
@@ -885,8 +1144,9 @@ uacpi_status uacpi_namespace_do_for_each_child(
             }
 
             decision = cb(user, node, depth);
+            // The lock has already been dropped above
             if (decision == UACPI_ITERATION_DECISION_BREAK)
-                goto out;
+                return ret;
 
             if (should_lock == UACPI_SHOULD_LOCK_YES) {
                 ret = uacpi_namespace_read_lock();
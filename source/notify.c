@@ -77,6 +77,10 @@ uacpi_status uacpi_notify_all(uacpi_namespace_node *node, uacpi_u64 value)
     if (uacpi_unlikely(node_object == UACPI_NULL))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
+    // Bus & device checks usually come with a change in interrupt routing
+    if (node_object->type == UACPI_OBJECT_DEVICE)
+        uacpi_invalidate_pci_routing_cache();
+
     ret = uacpi_acquire_native_mutex(notify_mutex);
     if (uacpi_unlikely_error(ret))
         return ret;
@@ -7,6 +7,7 @@
 #include <uacpi/internal/utilities.h>
 #include <uacpi/internal/mutex.h>
 #include <uacpi/internal/interpreter.h>
+#include <uacpi/internal/context.h>
 
 struct uacpi_recursive_lock g_opregion_lock;
 
@@ -86,6 +87,35 @@ void uacpi_trace_region_io(
 #endif
 }
 
+static void trace_region_block_io(
+    uacpi_namespace_node *node, uacpi_address_space space, uacpi_region_op op,
+    uacpi_u64 offset, uacpi_size length
+)
+{
+#ifdef UACPI_TRACE_REGION_IO
+    const uacpi_char *path;
+
+    if (!uacpi_should_log(UACPI_LOG_TRACE))
+        return;
+
+    path = uacpi_namespace_node_generate_absolute_path(node);
+
+    uacpi_trace(
+        "block %s [%s] (%zu bytes) %s[0x%016"UACPI_PRIX64"]\n",
+        op == UACPI_REGION_OP_READ_BLOCK ? "read from" : "write to", path,
+        length, uacpi_address_space_to_string(space), UACPI_FMT64(offset)
+    );
+
+    uacpi_free_dynamic_string(path);
+#else
+    UACPI_UNUSED(op);
+    UACPI_UNUSED(node);
+    UACPI_UNUSED(space);
+    UACPI_UNUSED(offset);
+    UACPI_UNUSED(length);
+#endif
+}
+
 static uacpi_bool space_needs_reg(enum uacpi_address_space space)
 {
     if (space == UACPI_ADDRESS_SPACE_SYSTEM_MEMORY ||
@@ -781,22 +811,12 @@ out:
     return ret;
 }
 
-uacpi_status uacpi_dispatch_opregion_io(
-    uacpi_namespace_node *region_node, uacpi_u32 offset, uacpi_u8 byte_width,
-    uacpi_region_op op, uacpi_u64 *in_out
+uacpi_status uacpi_opregion_io_begin(
+    uacpi_namespace_node *region_node, uacpi_object **out_obj
 )
 {
     uacpi_status ret;
     uacpi_object *obj;
-    uacpi_operation_region *region;
-    uacpi_address_space_handler *handler;
-    uacpi_address_space space;
-    uacpi_u64 offset_end;
-
-    uacpi_region_rw_data data = {
-        .byte_width = byte_width,
-        .offset = offset,
-    };
 
     ret = upgrade_to_opregion_lock();
     if (uacpi_unlikely_error(ret))
@@ -807,7 +827,7 @@ uacpi_status uacpi_dispatch_opregion_io(
         uacpi_trace_region_error(
             region_node, "unable to attach", ret
         );
-        goto out;
+        goto out_error;
     }
 
     obj = uacpi_namespace_node_get_object_typed(
@@ -815,34 +835,98 @@ uacpi_status uacpi_dispatch_opregion_io(
     );
     if (uacpi_unlikely(obj == UACPI_NULL)) {
         ret = UACPI_STATUS_INVALID_ARGUMENT;
-        goto out;
+        goto out_error;
     }
 
-    region = obj->op_region;
-    space = region->space;
-    handler = region->handler;
+    uacpi_object_ref(obj);
+    *out_obj = obj;
+    return UACPI_STATUS_OK;
+
+out_error:
+    uacpi_recursive_lock_release(&g_opregion_lock);
+    return ret;
+}
+
+void uacpi_opregion_io_end(uacpi_object *region_obj)
+{
+    uacpi_object_unref(region_obj);
+    uacpi_recursive_lock_release(&g_opregion_lock);
+}
+
+/*
+ * Validates that [offset, offset + length) is within the bounds of the region.
+ * The region is normally attached at this point, unless one of the previous
+ * handler calls in this IO sequence managed to detach it, in which case it's
+ * reattached here.
+ */
+static uacpi_status prepare_opregion_io(
+    uacpi_namespace_node *region_node, uacpi_operation_region *region,
+    uacpi_u32 offset, uacpi_u64 length, uacpi_u64 *out_address
+)
+{
+    uacpi_status ret;
+    uacpi_u64 offset_end, address;
+
+    if (uacpi_unlikely(
+        !(region->state_flags & UACPI_OP_REGION_STATE_ATTACHED)
+    )) {
+        ret = uacpi_opregion_attach(region_node);
+        if (uacpi_unlikely_error(ret)) {
+            uacpi_trace_region_error(
+                region_node, "unable to attach", ret
+            );
+            return ret;
+        }
+    }
 
     offset_end = offset;
-    offset_end += byte_width;
-    data.offset += region->offset;
+    offset_end += length;
+    address = offset;
+    address += region->offset;
 
     if (uacpi_unlikely(region->length < offset_end ||
-        data.offset < offset)) {
+        address < offset)) {
         const uacpi_char *path;
 
         path = uacpi_namespace_node_generate_absolute_path(region_node);
         uacpi_error(
             "out-of-bounds access to opregion %s[0x%"UACPI_PRIX64"->"
-            "0x%"UACPI_PRIX64"] at 0x%"UACPI_PRIX64" (idx=%u, width=%d)\n",
+            "0x%"UACPI_PRIX64"] at 0x%"UACPI_PRIX64" (idx=%u, width=%"
+            UACPI_PRIu64")\n",
             path, UACPI_FMT64(region->offset),
             UACPI_FMT64(region->offset + region->length),
-            UACPI_FMT64(data.offset), offset, byte_width
+            UACPI_FMT64(address), offset, UACPI_FMT64(length)
         );
         uacpi_free_dynamic_string(path);
-        ret = UACPI_STATUS_AML_OUT_OF_BOUNDS_INDEX;
-        goto out;
+        return UACPI_STATUS_AML_OUT_OF_BOUNDS_INDEX;
     }
 
+    *out_address = address;
+    return UACPI_STATUS_OK;
+}
+
+uacpi_status uacpi_opregion_io(
+    uacpi_namespace_node *region_node, uacpi_object *region_obj,
+    uacpi_u32 offset, uacpi_u8 byte_width, uacpi_region_op op,
+    uacpi_u64 *in_out
+)
+{
+    uacpi_status ret;
+    uacpi_operation_region *region = region_obj->op_region;
+    uacpi_address_space_handler *handler;
+    uacpi_address_space space = region->space;
+
+    uacpi_region_rw_data data = {
+        .byte_width = byte_width,
+    };
+
+    ret = prepare_opregion_io(
+        region_node, region, offset, byte_width, &data.offset
+    );
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    handler = region->handler;
     data.handler_context = handler->user_context;
     data.region_context = region->user_context;
 
@@ -854,17 +938,13 @@ uacpi_status uacpi_dispatch_opregion_io(
         );
     }
 
-    uacpi_object_ref(obj);
     uacpi_namespace_write_unlock();
-
     ret = handler->callback(op, &data);
-
     uacpi_namespace_write_lock();
-    uacpi_object_unref(obj);
 
     if (uacpi_unlikely_error(ret)) {
         uacpi_trace_region_error(region_node, "unable to perform IO", ret);
-        goto out;
+        return ret;
     }
 
     if (op == UACPI_REGION_OP_READ) {
@@ -875,7 +955,53 @@ uacpi_status uacpi_dispatch_opregion_io(
         );
     }
 
-out:
-    uacpi_recursive_lock_release(&g_opregion_lock);
+    return UACPI_STATUS_OK;
+}
+
+uacpi_status uacpi_opregion_block_io(
+    uacpi_namespace_node *region_node, uacpi_object *region_obj,
+    uacpi_u32 offset, uacpi_u8 byte_width, uacpi_region_op op,
+    void *buffer, uacpi_size length
+)
+{
+    uacpi_status ret;
+    uacpi_operation_region *region = region_obj->op_region;
+    uacpi_address_space_handler *handler = region->handler;
+
+    uacpi_region_block_rw_data data = {
+        .buffer = buffer,
+        .length = length,
+        .byte_width = byte_width,
+    };
+
+    if (handler == UACPI_NULL ||
+        !(handler->flags & UACPI_ADDRESS_SPACE_HANDLER_BLOCK_ACCESS))
+        return UACPI_STATUS_UNIMPLEMENTED;
+
+    ret = prepare_opregion_io(
+        region_node, region, offset, length, &data.offset
+    );
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    // The region might have been reattached to a different handler
+    handler = region->handler;
+    if (!(handler->flags & UACPI_ADDRESS_SPACE_HANDLER_BLOCK_ACCESS))
+        return UACPI_STATUS_UNIMPLEMENTED;
+
+    data.handler_context = handler->user_context;
+    data.region_context = region->user_context;
+
+    trace_region_block_io(
+        region_node, region->space, op, data.offset, length
+    );
+
+    uacpi_namespace_write_unlock();
+    ret = handler->callback(op, &data);
+    uacpi_namespace_write_lock();
+
+    if (uacpi_unlikely_error(ret))
+        uacpi_trace_region_error(region_node, "unable to perform IO", ret);
+
     return ret;
 }
@@ -14,11 +14,19 @@ struct registered_interface {
     // Only applicable for predefined host interfaces
     uacpi_u8 host_type;
 
-    // Only applicable for predefined interfaces
-    uacpi_u8 disabled : 1;
+    /*
+     * Both of these are read without holding the interface mutex, so they
+     * must only be accessed atomically.
+     */
+    uacpi_u8 disabled;
+
+    // Only applicable for dynamic interfaces, see uacpi_uninstall_interface
+    uacpi_u8 removed;
+
     uacpi_u8 dynamic : 1;
 
     struct registered_interface *next;
+    struct registered_interface *hash_next;
 };
 
 static uacpi_handle interface_mutex;
@@ -26,6 +34,20 @@ static struct registered_interface *registered_interfaces;
 static uacpi_interface_handler interface_handler;
 static uacpi_u32 latest_queried_interface;
 
+/*
+ * Interfaces are additionally hashed by name into a fixed set of buckets,
+ * which are only ever modified by prepending fully initialized entries, so
+ * that _OSI can be answered without taking the interface mutex.
+ *
+ * The multiplier below was picked such that every predefined interface ends
+ * up in a bucket of its own, making lookups of those a single string compare.
+ * Dynamically installed interfaces are prepended to the same buckets, and are
+ * never freed until deinitialization for the same reason.
+ */
+#define INTERFACE_HASH_BITS 6
+#define INTERFACE_HASH_MULTIPLIER 0x1479
+static struct registered_interface *interface_buckets[1 << INTERFACE_HASH_BITS];
+
 #define WINDOWS(string, interface)                            \
     {                                                         \
         .name = "Windows "string,                             \
@@ -33,8 +55,10 @@ static uacpi_u32 latest_queried_interface;
         .kind = UACPI_INTERFACE_KIND_VENDOR,                  \
         .host_type = 0,                                       \
         .disabled = 0,                                        \
+        .removed = 0,                                         \
         .dynamic = 0,                                         \
-        .next = UACPI_NULL                                    \
+        .next = UACPI_NULL,                                   \
+        .hash_next = UACPI_NULL                               \
     }
 
 #define HOST_FEATURE(string, type)                \
@@ -44,8 +68,10 @@ static uacpi_u32 latest_queried_interface;
         .kind = UACPI_INTERFACE_KIND_FEATURE,     \
         .host_type = UACPI_HOST_INTERFACE_##type, \
         .disabled = 1,                            \
+        .removed = 0,                             \
         .dynamic = 0,                             \
         .next = UACPI_NULL,                       \
+        .hash_next = UACPI_NULL,                  \
     }
 
 static struct registered_interface predefined_interfaces[] = {
@@ -85,6 +111,28 @@ static struct registered_interface predefined_interfaces[] = {
     { .name = "Extended Address Space Descriptor" },
 };
 
+static uacpi_size interface_hash(const uacpi_char *name)
+{
+    uacpi_u32 hash = 0x811C9DC5;
+
+    while (*name) {
+        hash ^= (uacpi_u8)*name++;
+        hash *= 0x01000193;
+    }
+
+    hash *= INTERFACE_HASH_MULTIPLIER;
+    return hash >> (32 - INTERFACE_HASH_BITS);
+}
+
+static void interface_hash_insert(struct registered_interface *interface)
+{
+    struct registered_interface **bucket;
+
+    bucket = &interface_buckets[interface_hash(interface->name)];
+    interface->hash_next = *bucket;
+    uacpi_atomic_store_ptr(bucket, interface);
+}
+
 uacpi_status uacpi_initialize_interfaces(void)
 {
     uacpi_size i;
@@ -95,8 +143,12 @@ uacpi_status uacpi_initialize_interfaces(void)
     if (uacpi_unlikely(interface_mutex == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
-    for (i = 0; i < (UACPI_ARRAY_SIZE(predefined_interfaces) - 1); ++i)
-        predefined_interfaces[i].next = &predefined_interfaces[i + 1];
+    for (i = 0; i < UACPI_ARRAY_SIZE(predefined_interfaces); ++i) {
+        if (i != (UACPI_ARRAY_SIZE(predefined_interfaces) - 1))
+            predefined_interfaces[i].next = &predefined_interfaces[i + 1];
+
+        interface_hash_insert(&predefined_interfaces[i]);
+    }
 
     return UACPI_STATUS_OK;
 }
@@ -110,6 +162,7 @@ void uacpi_deinitialize_interfaces(void)
         next_iface = iface->next;
 
         iface->next = UACPI_NULL;
+        iface->hash_next = UACPI_NULL;
 
         if (iface->dynamic) {
             uacpi_free_dynamic_string(iface->name);
@@ -129,6 +182,7 @@ void uacpi_deinitialize_interfaces(void)
     interface_handler = UACPI_NULL;
     latest_queried_interface = 0;
     registered_interfaces = UACPI_NULL;
+    uacpi_memzero(interface_buckets, sizeof(interface_buckets));
 }
 
 uacpi_vendor_interface uacpi_latest_queried_vendor_interface(void)
@@ -136,17 +190,24 @@ uacpi_vendor_interface uacpi_latest_queried_vendor_interface(void)
     return uacpi_atomic_load32(&latest_queried_interface);
 }
 
-static struct registered_interface *find_interface_unlocked(
-    const uacpi_char *name
-)
+/*
+ * Safe to call without holding the interface mutex. Note that this also
+ * returns dynamic interfaces that have been uninstalled, callers must check
+ * the 'removed' flag themselves.
+ */
+static struct registered_interface *find_interface(const uacpi_char *name)
 {
-    struct registered_interface *interface = registered_interfaces;
+    struct registered_interface *interface;
+
+    interface = (struct registered_interface*)uacpi_atomic_load_ptr(
+        &interface_buckets[interface_hash(name)]
+    );
 
     while (interface) {
         if (uacpi_strcmp(interface->name, name) == 0)
             return interface;
 
-        interface = interface->next;
+        interface = interface->hash_next;
     }
 
     return UACPI_NULL;
@@ -183,12 +244,20 @@ uacpi_status uacpi_install_interface(
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    interface = find_interface_unlocked(name);
+    interface = find_interface(name);
     if (interface != UACPI_NULL) {
-        if (interface->disabled)
-            interface->disabled = UACPI_FALSE;
-
         ret = UACPI_STATUS_ALREADY_EXISTS;
+
+        // Bring back a previously uninstalled interface as if it was new
+        if (interface->removed) {
+            interface->kind = kind;
+            uacpi_atomic_store8(&interface->disabled, UACPI_FALSE);
+            uacpi_atomic_store8(&interface->removed, UACPI_FALSE);
+            ret = UACPI_STATUS_OK;
+        } else if (interface->disabled) {
+            uacpi_atomic_store8(&interface->disabled, UACPI_FALSE);
+        }
+
         goto out;
     }
 
@@ -212,9 +281,11 @@ uacpi_status uacpi_install_interface(
     interface->kind = kind;
     interface->host_type = 0;
     interface->disabled = 0;
+    interface->removed = 0;
     interface->dynamic = 1;
     interface->next = registered_interfaces;
     registered_interfaces = interface;
+    interface_hash_insert(interface);
 
 out:
     uacpi_release_native_mutex(interface_mutex);
@@ -223,7 +294,7 @@ out:
 
 uacpi_status uacpi_uninstall_interface(const uacpi_char *name)
 {
-    struct registered_interface *cur, *prev;
+    struct registered_interface *interface;
     uacpi_status ret;
 
     UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
@@ -232,44 +303,35 @@ uacpi_status uacpi_uninstall_interface(const uacpi_char *name)
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    cur = registered_interfaces;
-    prev = cur;
-
     ret = UACPI_STATUS_NOT_FOUND;
-    while (cur) {
-        if (uacpi_strcmp(cur->name, name) != 0) {
-            prev = cur;
-            cur = cur->next;
-            continue;
-        }
 
-        if (cur->dynamic) {
-            if (prev == cur) {
-                registered_interfaces = cur->next;
-            } else {
-                prev->next = cur->next;
-            }
-
-            uacpi_release_native_mutex(interface_mutex);
-            uacpi_free_dynamic_string(cur->name);
-            uacpi_free(cur, sizeof(*cur));
-            return UACPI_STATUS_OK;
-        }
+    interface = find_interface(name);
+    if (interface == UACPI_NULL || interface->removed)
+        goto out;
 
-        /*
-         * If this interface was already disabled, pretend we didn't actually
-         * find it and keep ret as UACPI_STATUS_NOT_FOUND. The fact that it's
-         * still in the registered list is an implementation detail of
-         * predefined interfaces.
-         */
-        if (!cur->disabled) {
-            cur->disabled = UACPI_TRUE;
-            ret = UACPI_STATUS_OK;
-        }
+    /*
+     * Dynamic interfaces cannot be freed here as _OSI might be looking at
+     * them concurrently, mark them as removed instead. They are reused if the
+     * same interface is installed again and freed during deinitialization.
+     */
+    if (interface->dynamic) {
+        uacpi_atomic_store8(&interface->removed, UACPI_TRUE);
+        ret = UACPI_STATUS_OK;
+        goto out;
+    }
 
-        break;
+    /*
+     * If this interface was already disabled, pretend we didn't actually
+     * find it and keep ret as UACPI_STATUS_NOT_FOUND. The fact that it's
+     * still in the registered list is an implementation detail of
+     * predefined interfaces.
+     */
+    if (!interface->disabled) {
+        uacpi_atomic_store8(&interface->disabled, UACPI_TRUE);
+        ret = UACPI_STATUS_OK;
     }
 
+out:
     uacpi_release_native_mutex(interface_mutex);
     return ret;
 }
@@ -293,7 +355,7 @@ static uacpi_status configure_host_interface(
         goto out;
     }
 
-    interface->disabled = !enabled;
+    uacpi_atomic_store8(&interface->disabled, !enabled);
 out:
     uacpi_release_native_mutex(interface_mutex);
     return ret;
@@ -326,7 +388,7 @@ uacpi_status uacpi_set_interface_query_handler(
         goto out;
     }
 
-    interface_handler = handler;
+    uacpi_atomic_store_ptr(&interface_handler, handler);
 out:
     uacpi_release_native_mutex(interface_mutex);
     return ret;
@@ -347,8 +409,12 @@ uacpi_status uacpi_bulk_configure_interfaces(
 
     interface = registered_interfaces;
     while (interface) {
-        if (kind & interface->kind)
-            interface->disabled = (action == UACPI_INTERFACE_ACTION_DISABLE);
+        if (kind & interface->kind) {
+            uacpi_atomic_store8(
+                &interface->disabled,
+                action == UACPI_INTERFACE_ACTION_DISABLE
+            );
+        }
 
         interface = interface->next;
     }
@@ -359,26 +425,31 @@ uacpi_status uacpi_bulk_configure_interfaces(
 
 uacpi_status uacpi_handle_osi(const uacpi_char *string, uacpi_bool *out_value)
 {
-    uacpi_status ret;
     struct registered_interface *interface;
+    uacpi_interface_handler handler;
+    uacpi_u32 latest;
     uacpi_bool is_supported = UACPI_FALSE;
 
-    ret = uacpi_acquire_native_mutex(interface_mutex);
-    if (uacpi_unlikely_error(ret))
-        return ret;
-
-    interface = find_interface_unlocked(string);
-    if (interface == UACPI_NULL)
+    interface = find_interface(string);
+    if (interface == UACPI_NULL || uacpi_atomic_load8(&interface->removed))
         goto out;
 
-    if (interface->weight > latest_queried_interface)
-        uacpi_atomic_store32(&latest_queried_interface, interface->weight);
+    latest = uacpi_atomic_load32(&latest_queried_interface);
+    while (interface->weight > latest) {
+        if (uacpi_atomic_cmpxchg32(
+                &latest_queried_interface, &latest, interface->weight
+            ))
+            break;
+    }
 
-    is_supported = !interface->disabled;
-    if (interface_handler)
-        is_supported = interface_handler(string, is_supported);
+    is_supported = !uacpi_atomic_load8(&interface->disabled);
+
+    handler = (uacpi_interface_handler)uacpi_atomic_load_ptr(
+        &interface_handler
+    );
+    if (handler)
+        is_supported = handler(string, is_supported);
 out:
-    uacpi_release_native_mutex(interface_mutex);
     *out_value = is_supported;
     return UACPI_STATUS_OK;
 }
@@ -0,0 +1,293 @@
+#include <uacpi/uacpi.h>
+#include <uacpi/platform/atomic.h>
+#include <uacpi/internal/pool.h>
+#include <uacpi/internal/stdlib.h>
+#include <uacpi/internal/log.h>
+#include <uacpi/internal/helpers.h>
+#include <uacpi/kernel_api.h>
+
+#ifdef UACPI_POOL_ALLOCATOR
+
+struct pool_block {
+    struct pool_block *next;
+};
+
+/*
+ * Every chunk starts with this header, padded so that the blocks following it
+ * stay 16-byte aligned.
+ */
+struct pool_chunk {
+    struct pool_chunk *next;
+};
+
+#define POOL_CHUNK_HEADER_SIZE 16
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    sizeof(struct pool_chunk) > POOL_CHUNK_HEADER_SIZE,
+    "pool chunk header doesn't fit into the reserved space"
+);
+
+struct pool {
+    // See pool_lock()
+    uacpi_handle spinlock;
+    uacpi_u32 lock;
+    uacpi_u32 block_size;
+
+    struct pool_block *free_list;
+    struct pool_chunk *chunks;
+
+    uacpi_size num_chunks;
+    uacpi_size blocks_in_use;
+    uacpi_size peak_blocks_in_use;
+    uacpi_u64 total_allocations;
+};
+
+#define POOL_GRANULARITY 16
+#define POOL_MAX_BLOCK_SIZE 128
+
+static struct pool pools[] = {
+    { .block_size = 16 },
+    { .block_size = 32 },
+    { .block_size = 48 },
+    { .block_size = 64 },
+    { .block_size = 96 },
+    { .block_size = 128 },
+};
+
+// Indexed by (size - 1) / POOL_GRANULARITY
+static const uacpi_u8 size_to_pool_idx[POOL_MAX_BLOCK_SIZE / POOL_GRANULARITY] = {
+    0, 1, 2, 3, 4, 4, 5, 5,
+};
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_POOL_CHUNK_SIZE < POOL_CHUNK_HEADER_SIZE + POOL_MAX_BLOCK_SIZE * 4,
+    "configured pool chunk size is too small"
+);
+
+static struct pool *pool_for_size(uacpi_size size)
+{
+    if (uacpi_unlikely(size == 0 || size > POOL_MAX_BLOCK_SIZE))
+        return UACPI_NULL;
+
+    return &pools[size_to_pool_idx[(size - 1) / POOL_GRANULARITY]];
+}
+
+/*
+ * Pools are used before any kernel API objects are guaranteed to exist (e.g.
+ * by the resource API or early object creation), so until uacpi_initialize
+ * creates a kernel spinlock for every pool they are protected by a tiny atomic
+ * test-and-set lock instead. That lock neither disables interrupts nor
+ * preemption, so before uacpi_initialize pool allocations must not be done
+ * from interrupt context. Critical sections are only ever a few instructions
+ * long and never call out into the host.
+ *
+ * The switch from the atomic lock to the kernel spinlock is not synchronized
+ * in any way, which is fine as uacpi_initialize must not race with any other
+ * uACPI API.
+ */
+static uacpi_cpu_flags pool_lock(struct pool *pool)
+{
+    uacpi_u32 expected;
+
+    if (pool->spinlock != UACPI_NULL)
+        return uacpi_kernel_lock_spinlock(pool->spinlock);
+
+    for (;;) {
+        expected = 0;
+        if (uacpi_atomic_cmpxchg32(&pool->lock, &expected, 1))
+            return 0;
+
+        while (uacpi_atomic_load32(&pool->lock) != 0)
+            UACPI_ARCH_SPIN_LOOP_HINT();
+    }
+}
+
+static void pool_unlock(struct pool *pool, uacpi_cpu_flags flags)
+{
+    if (pool->spinlock != UACPI_NULL) {
+        uacpi_kernel_unlock_spinlock(pool->spinlock, flags);
+        return;
+    }
+
+    uacpi_atomic_store32(&pool->lock, 0);
+}
+
+static void pool_add_chunk(struct pool *pool, struct pool_chunk *chunk)
+{
+    uacpi_u8 *cursor, *end;
+    struct pool_block *block;
+
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->num_chunks++;
+
+    cursor = (uacpi_u8*)chunk + POOL_CHUNK_HEADER_SIZE;
+    end = (uacpi_u8*)chunk + UACPI_POOL_CHUNK_SIZE;
+
+    for (; cursor + pool->block_size <= end; cursor += pool->block_size) {
+        block = (struct pool_block*)cursor;
+        block->next = pool->free_list;
+        pool->free_list = block;
+    }
+}
+
+void *uacpi_pool_alloc(uacpi_size size)
+{
+    struct pool *pool;
+    struct pool_block *block;
+    struct pool_chunk *chunk;
+    uacpi_cpu_flags flags;
+
+    pool = pool_for_size(size);
+    if (pool == UACPI_NULL)
+        return uacpi_kernel_alloc(size);
+
+    flags = pool_lock(pool);
+
+    while (pool->free_list == UACPI_NULL) {
+        // Don't call into the host with the lock held
+        pool_unlock(pool, flags);
+
+        chunk = uacpi_kernel_alloc(UACPI_POOL_CHUNK_SIZE);
+        if (uacpi_unlikely(chunk == UACPI_NULL))
+            return UACPI_NULL;
+
+        flags = pool_lock(pool);
+        pool_add_chunk(pool, chunk);
+    }
+
+    block = pool->free_list;
+    pool->free_list = block->next;
+
+    pool->total_allocations++;
+    if (++pool->blocks_in_use > pool->peak_blocks_in_use)
+        pool->peak_blocks_in_use = pool->blocks_in_use;
+
+    pool_unlock(pool, flags);
+    return block;
+}
+
+void *uacpi_pool_alloc_zeroed(uacpi_size size)
+{
+    void *ret;
+
+    if (pool_for_size(size) == UACPI_NULL)
+        return uacpi_kernel_alloc_zeroed(size);
+
+    ret = uacpi_pool_alloc(size);
+    if (uacpi_unlikely(ret == UACPI_NULL))
+        return ret;
+
+    uacpi_memzero(ret, size);
+    return ret;
+}
+
+void uacpi_pool_free(void *ptr, uacpi_size size)
+{
+    struct pool *pool;
+    struct pool_block *block = ptr;
+    uacpi_cpu_flags flags;
+
+    if (ptr == UACPI_NULL)
+        return;
+
+    pool = pool_for_size(size);
+    if (pool == UACPI_NULL) {
+        uacpi_free(ptr, size);
+        return;
+    }
+
+    flags = pool_lock(pool);
+    block->next = pool->free_list;
+    pool->free_list = block;
+    pool->blocks_in_use--;
+    pool_unlock(pool, flags);
+}
+
+uacpi_status uacpi_initialize_pools(void)
+{
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_ARRAY_SIZE(pools); ++i) {
+        pools[i].spinlock = uacpi_kernel_create_spinlock();
+        if (uacpi_unlikely(pools[i].spinlock == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+void uacpi_deinitialize_pools(void)
+{
+    struct pool *pool;
+    struct pool_chunk *chunk, *next_chunk;
+    uacpi_cpu_flags flags;
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_ARRAY_SIZE(pools); ++i) {
+        pool = &pools[i];
+
+        // Pools may still be used after this, fall back to the atomic lock
+        if (pool->spinlock != UACPI_NULL) {
+            uacpi_kernel_free_spinlock(pool->spinlock);
+            pool->spinlock = UACPI_NULL;
+        }
+
+        flags = pool_lock(pool);
+
+        if (pool->blocks_in_use != 0) {
+            uacpi_trace(
+                "not releasing %zu-byte pool: %zu blocks still in use\n",
+                (uacpi_size)pool->block_size, pool->blocks_in_use
+            );
+            pool_unlock(pool, flags);
+            continue;
+        }
+
+        chunk = pool->chunks;
+        pool->chunks = UACPI_NULL;
+        pool->free_list = UACPI_NULL;
+        pool->num_chunks = 0;
+        pool->peak_blocks_in_use = 0;
+        pool->total_allocations = 0;
+        pool_unlock(pool, flags);
+
+        while (chunk != UACPI_NULL) {
+            next_chunk = chunk->next;
+            uacpi_free(chunk, UACPI_POOL_CHUNK_SIZE);
+            chunk = next_chunk;
+        }
+    }
+}
+
+uacpi_status uacpi_get_pool_stats(uacpi_u32 idx, uacpi_pool_stats *out_stats)
+{
+    struct pool *pool;
+    uacpi_cpu_flags flags;
+
+    if (idx >= UACPI_ARRAY_SIZE(pools))
+        return UACPI_STATUS_NOT_FOUND;
+
+    pool = &pools[idx];
+    flags = pool_lock(pool);
+
+    out_stats->block_size = pool->block_size;
+    out_stats->num_chunks = pool->num_chunks;
+    out_stats->blocks_in_use = pool->blocks_in_use;
+    out_stats->peak_blocks_in_use = pool->peak_blocks_in_use;
+    out_stats->total_allocations = pool->total_allocations;
+
+    pool_unlock(pool, flags);
+    return UACPI_STATUS_OK;
+}
+
+#else
+
+uacpi_status uacpi_get_pool_stats(uacpi_u32 idx, uacpi_pool_stats *out_stats)
+{
+    UACPI_UNUSED(idx);
+    UACPI_UNUSED(out_stats);
+    return UACPI_STATUS_COMPILED_OUT;
+}
+
+#endif
@@ -92,38 +92,66 @@ static const struct register_spec *get_reg(uacpi_u8 idx)
     return &registers[idx];
 }
 
+/*
+ * All GAS registers are mapped once at initialization, so that accessing
+ * them (e.g. PM1 status from the SCI handler, or the PM timer) doesn't need
+ * a map/unmap pair on every access. Registers that couldn't be mapped are
+ * accessed via the plain GAS path instead, which reports the error.
+ */
+struct register_mapping {
+    uacpi_mapped_gas mappings[2];
+    uacpi_bool mapped[2];
+};
+static struct register_mapping g_register_mappings[UACPI_REGISTER_MAX + 1];
+
 static uacpi_status read_one(
-    enum register_kind kind, void *reg, uacpi_u8 byte_width,
-    uacpi_u64 *out_value
+    const struct register_spec *reg, uacpi_u8 idx, uacpi_u64 *out_value
 )
 {
-    if (kind == REGISTER_KIND_GAS) {
-        struct acpi_gas *gas = reg;
+    void *accessor = idx == 0 ? reg->accessor0 : reg->accessor1;
+
+    if (reg->kind == REGISTER_KIND_GAS) {
+        struct register_mapping *mapping;
+        struct acpi_gas *gas = accessor;
+
+        mapping = &g_register_mappings[reg - registers];
+        if (mapping->mapped[idx])
+            return uacpi_gas_read_mapped(&mapping->mappings[idx], out_value);
 
         if (!gas->address)
             return UACPI_STATUS_OK;
 
-        return uacpi_gas_read(reg, out_value);
+        return uacpi_gas_read(gas, out_value);
     }
 
-    return uacpi_system_io_read(*(uacpi_u32*)reg, byte_width, out_value);
+    return uacpi_system_io_read(
+        *(uacpi_u32*)accessor, reg->access_width, out_value
+    );
 }
 
 static uacpi_status write_one(
-    enum register_kind kind, void *reg, uacpi_u8 byte_width,
-    uacpi_u64 in_value
+    const struct register_spec *reg, uacpi_u8 idx, uacpi_u64 in_value
 )
 {
-    if (kind == REGISTER_KIND_GAS) {
-        struct acpi_gas *gas = reg;
+    void *accessor = idx == 0 ? reg->accessor0 : reg->accessor1;
+
+    if (reg->kind == REGISTER_KIND_GAS) {
+        struct register_mapping *mapping;
+        struct acpi_gas *gas = accessor;
+
+        mapping = &g_register_mappings[reg - registers];
+        if (mapping->mapped[idx])
+            return uacpi_gas_write_mapped(&mapping->mappings[idx], in_value);
 
         if (!gas->address)
             return UACPI_STATUS_OK;
 
-        return uacpi_gas_write(reg, in_value);
+        return uacpi_gas_write(gas, in_value);
     }
 
-    return uacpi_system_io_write(*(uacpi_u32*)reg, byte_width, in_value);
+    return uacpi_system_io_write(
+        *(uacpi_u32*)accessor, reg->access_width, in_value
+    );
 }
 
 static uacpi_status do_read_register(
@@ -133,12 +161,12 @@ static uacpi_status do_read_register(
     uacpi_status ret;
     uacpi_u64 value0, value1 = 0;
 
-    ret = read_one(reg->kind, reg->accessor0, reg->access_width, &value0);
+    ret = read_one(reg, 0, &value0);
     if (uacpi_unlikely_error(ret))
         return ret;
 
     if (reg->accessor1) {
-        ret = read_one(reg->kind, reg->accessor1, reg->access_width, &value1);
+        ret = read_one(reg, 1, &value1);
         if (uacpi_unlikely_error(ret))
             return ret;
     }
@@ -183,12 +211,12 @@ static uacpi_status do_write_register(
         }
     }
 
-    ret = write_one(reg->kind, reg->accessor0, reg->access_width, in_value);
+    ret = write_one(reg, 0, in_value);
     if (uacpi_unlikely_error(ret))
         return ret;
 
     if (reg->accessor1)
-        ret = write_one(reg->kind, reg->accessor1, reg->access_width, in_value);
+        ret = write_one(reg, 1, in_value);
 
     return ret;
 }
@@ -217,12 +245,12 @@ uacpi_status uacpi_write_registers(
     if (uacpi_unlikely(reg == UACPI_NULL))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
-    ret = write_one(reg->kind, reg->accessor0, reg->access_width, in_value0);
+    ret = write_one(reg, 0, in_value0);
     if (uacpi_unlikely_error(ret))
         return ret;
 
     if (reg->accessor1)
-        ret = write_one(reg->kind, reg->accessor1, reg->access_width, in_value1);
+        ret = write_one(reg, 1, in_value1);
 
     return ret;
 }
@@ -353,17 +381,71 @@ static const struct register_field fields[UACPI_REGISTER_FIELD_MAX + 1] = {
 
 static uacpi_handle g_reg_lock;
 
+static void map_registers(void)
+{
+    uacpi_size i, j;
+    const struct register_spec *reg;
+    struct register_mapping *mapping;
+    void *accessors[2];
+    uacpi_status ret;
+
+    for (i = 0; i <= UACPI_REGISTER_MAX; ++i) {
+        reg = &registers[i];
+        mapping = &g_register_mappings[i];
+
+        if (reg->kind != REGISTER_KIND_GAS)
+            continue;
+
+        accessors[0] = reg->accessor0;
+        accessors[1] = reg->accessor1;
+
+        for (j = 0; j < 2; ++j) {
+            struct acpi_gas *gas = accessors[j];
+
+            if (gas == UACPI_NULL || !gas->address)
+                continue;
+
+            ret = uacpi_map_gas_noalloc(gas, &mapping->mappings[j]);
+            if (uacpi_unlikely_error(ret))
+                continue;
+
+            mapping->mapped[j] = UACPI_TRUE;
+        }
+    }
+}
+
+static void unmap_registers(void)
+{
+    uacpi_size i, j;
+    struct register_mapping *mapping;
+
+    for (i = 0; i <= UACPI_REGISTER_MAX; ++i) {
+        mapping = &g_register_mappings[i];
+
+        for (j = 0; j < 2; ++j) {
+            if (!mapping->mapped[j])
+                continue;
+
+            uacpi_unmap_gas_nofree(&mapping->mappings[j]);
+            mapping->mapped[j] = UACPI_FALSE;
+        }
+    }
+}
+
 uacpi_status uacpi_ininitialize_registers(void)
 {
     g_reg_lock = uacpi_kernel_create_spinlock();
     if (uacpi_unlikely(g_reg_lock == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
+    map_registers();
     return UACPI_STATUS_OK;
 }
 
 void uacpi_deininitialize_registers(void)
 {
+    unmap_registers();
+
     if (g_reg_lock != UACPI_NULL) {
         uacpi_kernel_free_spinlock(g_reg_lock);
         g_reg_lock = UACPI_NULL;
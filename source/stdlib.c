@@ -2,34 +2,128 @@
 #include <uacpi/internal/utilities.h>
 #include <uacpi/platform/config.h>
 
-#ifndef uacpi_memcpy
-void *uacpi_memcpy(void *dest, const void *src, size_t count)
+#if !defined(uacpi_memcpy) || !defined(uacpi_memmove) || \
+    !defined(uacpi_memset) || !defined(uacpi_memcmp)
+
+/*
+ * Machine word sized accesses used by the builtin mem* helpers below. With
+ * GCC & clang these are allowed to alias anything and be misaligned, so only
+ * the destination has to be aligned (which is where misaligned accesses hurt
+ * the most), and the compiler picks the best access sequence for the target.
+ * Elsewhere word accesses are only used if both pointers are equally aligned.
+ */
+#ifdef __GNUC__
+typedef uacpi_uintptr __attribute__((__may_alias__, __aligned__(1)))
+    mem_word;
+
+#define CAN_ACCESS_WORDS(lhs, rhs) UACPI_TRUE
+
+/*
+ * Copy & fill 16 bytes at a time if the target is known to have vector
+ * registers available. Kernels that are built without SSE/NEON don't get
+ * these macros defined, which makes sure we don't touch vector registers.
+ */
+#if defined(__SSE2__) || defined(__ARM_NEON)
+typedef uacpi_u8 __attribute__((
+    __vector_size__(16), __may_alias__, __aligned__(1)
+)) mem_chunk;
+
+#define HAS_MEM_CHUNK
+#endif
+#else
+typedef uacpi_uintptr mem_word;
+
+#define CAN_ACCESS_WORDS(lhs, rhs) \
+    ((((uacpi_uintptr)(lhs) ^ (uacpi_uintptr)(rhs)) & (sizeof(mem_word) - 1)) == 0)
+#endif
+
+#define IS_WORD_ALIGNED(ptr) \
+    UACPI_IS_ALIGNED((uacpi_uintptr)(ptr), sizeof(mem_word), uacpi_uintptr)
+
+#endif
+
+#if !defined(uacpi_memcpy) || !defined(uacpi_memmove)
+static void copy_forward(uacpi_u8 *cd, const uacpi_u8 *cs, uacpi_size count)
 {
-    uacpi_char *cd = dest;
-    const uacpi_char *cs = src;
+    if (count >= sizeof(mem_word) && CAN_ACCESS_WORDS(cd, cs)) {
+        while (!IS_WORD_ALIGNED(cd)) {
+            *cd++ = *cs++;
+            count--;
+        }
+
+#ifdef HAS_MEM_CHUNK
+        while (count >= sizeof(mem_chunk)) {
+            *(mem_chunk*)cd = *(const mem_chunk*)cs;
+            cd += sizeof(mem_chunk);
+            cs += sizeof(mem_chunk);
+            count -= sizeof(mem_chunk);
+        }
+#endif
+
+        while (count >= sizeof(mem_word)) {
+            *(mem_word*)cd = *(const mem_word*)cs;
+            cd += sizeof(mem_word);
+            cs += sizeof(mem_word);
+            count -= sizeof(mem_word);
+        }
+    }
 
     while (count--)
         *cd++ = *cs++;
+}
+#endif
 
+#ifndef uacpi_memcpy
+void *uacpi_memcpy(void *dest, const void *src, size_t count)
+{
+    copy_forward(dest, src, count);
     return dest;
 }
 #endif
 
 #ifndef uacpi_memmove
-void *uacpi_memmove(void *dest, const void *src, uacpi_size count)
+/*
+ * Chunks are always fully read before they're written, so copying forward is
+ * safe for any overlap where dest is below src, and vice versa.
+ */
+static void copy_backward(uacpi_u8 *cd, const uacpi_u8 *cs, uacpi_size count)
 {
-    uacpi_char *cd = dest;
-    const uacpi_char *cs = src;
+    cd += count;
+    cs += count;
 
-    if (src < dest) {
-        cs += count;
-        cd += count;
-
-        while (count--)
+    if (count >= sizeof(mem_word) && CAN_ACCESS_WORDS(cd, cs)) {
+        while (!IS_WORD_ALIGNED(cd)) {
             *--cd = *--cs;
+            count--;
+        }
+
+#ifdef HAS_MEM_CHUNK
+        while (count >= sizeof(mem_chunk)) {
+            cd -= sizeof(mem_chunk);
+            cs -= sizeof(mem_chunk);
+            *(mem_chunk*)cd = *(const mem_chunk*)cs;
+            count -= sizeof(mem_chunk);
+        }
+#endif
+
+        while (count >= sizeof(mem_word)) {
+            cd -= sizeof(mem_word);
+            cs -= sizeof(mem_word);
+            *(mem_word*)cd = *(const mem_word*)cs;
+            count -= sizeof(mem_word);
+        }
+    }
+
+    while (count--)
+        *--cd = *--cs;
+}
+
+void *uacpi_memmove(void *dest, const void *src, uacpi_size count)
+{
+    if (src < dest) {
+        copy_backward(dest, src, count);
     } else {
-        while (count--)
-            *cd++ = *cs++;
+        copy_forward(dest, src, count);
     }
 
     return dest;
@@ -42,6 +136,33 @@ void *uacpi_memset(void *dest, uacpi_i32 ch, uacpi_size count)
     uacpi_u8 fill = ch;
     uacpi_u8 *cdest = dest;
 
+    if (count >= sizeof(mem_word)) {
+        uacpi_uintptr word_fill = ((uacpi_uintptr)~0ull / 0xFF) * fill;
+
+        while (!IS_WORD_ALIGNED(cdest)) {
+            *cdest++ = fill;
+            count--;
+        }
+
+#ifdef HAS_MEM_CHUNK
+        if (count >= sizeof(mem_chunk)) {
+            mem_chunk chunk_fill = (mem_chunk){ 0 } + fill;
+
+            do {
+                *(mem_chunk*)cdest = chunk_fill;
+                cdest += sizeof(mem_chunk);
+                count -= sizeof(mem_chunk);
+            } while (count >= sizeof(mem_chunk));
+        }
+#endif
+
+        while (count >= sizeof(mem_word)) {
+            *(mem_word*)cdest = word_fill;
+            cdest += sizeof(mem_word);
+            count -= sizeof(mem_word);
+        }
+    }
+
     while (count--)
         *cdest++ = fill;
 
@@ -54,9 +175,19 @@ uacpi_i32 uacpi_memcmp(const void *lhs, const void *rhs, uacpi_size count)
 {
     const uacpi_u8 *byte_lhs = lhs;
     const uacpi_u8 *byte_rhs = rhs;
-    uacpi_size i;
+    uacpi_size i = 0;
+
+    /*
+     * Skip over equal words, then find the exact mismatching byte (if any)
+     * in the slow loop below.
+     */
+    if (CAN_ACCESS_WORDS(byte_lhs, byte_rhs)) {
+        while ((count - i) >= sizeof(mem_word) &&
+               *(const mem_word*)&byte_lhs[i] == *(const mem_word*)&byte_rhs[i])
+            i += sizeof(mem_word);
+    }
 
-    for (i = 0; i < count; ++i) {
+    for (; i < count; ++i) {
         if (byte_lhs[i] != byte_rhs[i])
             return byte_lhs[i] - byte_rhs[i];
     }
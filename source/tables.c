@@ -25,6 +25,10 @@ static uacpi_status table_install_with_origin_unlocked(
     void *virt, enum uacpi_table_origin origin, uacpi_table *out_table
 );
 
+#ifdef UACPI_LAZY_TABLE_HEADERS
+static uacpi_status table_install_pending_unlocked(uacpi_phys_addr phys);
+#endif
+
 UACPI_PACKED(struct uacpi_rxsdt {
     struct acpi_sdt_hdr hdr;
     uacpi_u8 ptr_bytes[];
@@ -66,9 +70,13 @@ static uacpi_status initialize_from_rxsdt(uacpi_phys_addr rxsdt_addr,
                                           uacpi_size entry_size)
 {
     struct uacpi_rxsdt *rxsdt;
-    uacpi_size i, entry_bytes, map_len = sizeof(*rxsdt);
+    uacpi_size i, entry_count, map_len = sizeof(*rxsdt);
     uacpi_phys_addr entry_addr;
     uacpi_status ret;
+#ifdef UACPI_LAZY_TABLE_HEADERS
+    uacpi_bool lazy_headers = installation_handler == UACPI_NULL &&
+                              !uacpi_check_flag(UACPI_FLAG_PROACTIVE_TBL_CSUM);
+#endif
 
     rxsdt = uacpi_kernel_map(rxsdt_addr, map_len);
     if (rxsdt == UACPI_NULL)
@@ -87,9 +95,8 @@ static uacpi_status initialize_from_rxsdt(uacpi_phys_addr rxsdt_addr,
     if (uacpi_unlikely(map_len < (sizeof(*rxsdt) + entry_size)))
         return UACPI_STATUS_INVALID_TABLE_LENGTH;
 
-    // Make sure length is aligned to entry size so we don't OOB
-    entry_bytes = map_len - sizeof(*rxsdt);
-    entry_bytes &= ~(entry_size - 1);
+    // Round the entry count down so we don't OOB
+    entry_count = (map_len - sizeof(*rxsdt)) / entry_size;
 
     rxsdt = uacpi_kernel_map(rxsdt_addr, map_len);
     if (uacpi_unlikely(rxsdt == UACPI_NULL))
@@ -99,14 +106,33 @@ static uacpi_status initialize_from_rxsdt(uacpi_phys_addr rxsdt_addr,
     if (uacpi_unlikely_error(ret))
         goto error_out;
 
-    for (i = 0; i < entry_bytes; i += entry_size) {
-        uacpi_u64 entry_phys_addr_large = 0;
-        uacpi_memcpy(&entry_phys_addr_large, &rxsdt->ptr_bytes[i], entry_size);
+    for (i = 0; i < entry_count; ++i) {
+        uacpi_u64 entry_phys_addr_large;
+
+        // Both are packed, so this is safe for misaligned mappings as well
+        if (entry_size == 8)
+            entry_phys_addr_large = ((struct acpi_xsdt*)rxsdt)->entries[i];
+        else
+            entry_phys_addr_large = ((struct acpi_rsdt*)rxsdt)->entries[i];
 
         if (!entry_phys_addr_large)
             continue;
 
         entry_addr = uacpi_truncate_phys_addr_with_warn(entry_phys_addr_large);
+
+#ifdef UACPI_LAZY_TABLE_HEADERS
+        /*
+         * The FADT must be installed right away as it describes the rest of
+         * the hardware, so headers are read as usual until it's found.
+         */
+        if (lazy_headers && g_uacpi_rt_ctx.fadt.hdr.length != 0) {
+            ret = table_install_pending_unlocked(entry_addr);
+            if (uacpi_unlikely_error(ret))
+                goto error_out;
+            continue;
+        }
+#endif
+
         ret = uacpi_table_install_physical_with_origin(
             entry_addr, UACPI_TABLE_ORIGIN_FIRMWARE_PHYSICAL, UACPI_NULL
         );
@@ -207,9 +233,20 @@ static uacpi_iteration_decision warn_if_early_referenced(
 uacpi_status uacpi_initialize_tables(void)
 {
     if (early_table_access) {
-        uacpi_size num_tables;
+        uacpi_size num_tables, i;
+
+        /*
+         * Walk the array directly instead of using uacpi_for_each_table, as
+         * the latter would read the headers of all lazily installed tables.
+         */
+        for (i = 0; i < table_array_size(&tables); ++i) {
+            struct uacpi_installed_table *tbl = table_array_at(&tables, i);
 
-        uacpi_for_each_table(0, warn_if_early_referenced, UACPI_NULL);
+            if (tbl->flags & UACPI_TABLE_INVALID)
+                continue;
+
+            warn_if_early_referenced(UACPI_NULL, tbl, i);
+        }
 
         // Reallocate the user buffer into a normal heap array
         num_tables = table_array_size(&tables);
@@ -332,14 +369,78 @@ out:
 
 static uacpi_status initialize_fadt(const void*);
 
+/*
+ * The checksum is computed 8 (or 16 if vector registers are available) bytes
+ * at a time by splitting every step into its even & odd bytes and summing
+ * those into separate 16-bit lanes of an accumulator. Every step adds at most
+ * 2 * 0xFF to a lane, so the accumulator has to be folded back into the final
+ * byte sum every CSUM_STEPS_PER_FOLD steps, before a lane could overflow into
+ * the next one.
+ */
+#define CSUM_LANE_MASK 0x00FF00FF00FF00FFull
+#define CSUM_STEPS_PER_FOLD 128
+
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+typedef uacpi_u64 __attribute__((__vector_size__(16), __may_alias__))
+    csum_step;
+
+#define CSUM_FOLD(acc) (csum_fold(acc[0]) + csum_fold(acc[1]))
+#else
+#ifdef __GNUC__
+typedef uacpi_u64 __attribute__((__may_alias__)) csum_step;
+#else
+typedef uacpi_u64 csum_step;
+#endif
+
+#define CSUM_FOLD(acc) csum_fold(acc)
+#endif
+
+/*
+ * Table bytes are read through csum_step, which is only allowed if the type
+ * may alias anything. Fall back to a copy where that can't be expressed.
+ */
+#ifdef __GNUC__
+#define CSUM_LOAD(dst, src) (dst = *(const csum_step*)(src))
+#else
+#define CSUM_LOAD(dst, src) uacpi_memcpy(&(dst), src, sizeof(csum_step))
+#endif
+
+static uacpi_u8 csum_fold(uacpi_u64 acc)
+{
+    // Only the low byte of every lane matters for the final sum
+    return acc + (acc >> 16) + (acc >> 32) + (acc >> 48);
+}
+
 static uacpi_u8 table_checksum(void *table, uacpi_size size)
 {
-    uacpi_u8 *bytes = table;
+    const uacpi_u8 *bytes = table;
     uacpi_u8 csum = 0;
-    uacpi_size i;
+    uacpi_size steps;
+
+    while (size && !UACPI_IS_ALIGNED(
+            (uacpi_uintptr)bytes, sizeof(csum_step), uacpi_uintptr
+        )) {
+        csum += *bytes++;
+        size--;
+    }
 
-    for (i = 0; i < size; ++i)
-        csum += bytes[i];
+    while (size >= sizeof(csum_step)) {
+        csum_step step, acc = { 0 };
+
+        steps = UACPI_MIN(size / sizeof(csum_step), CSUM_STEPS_PER_FOLD);
+        size -= steps * sizeof(csum_step);
+
+        while (steps--) {
+            CSUM_LOAD(step, bytes);
+            acc += (step & CSUM_LANE_MASK) + ((step >> 8) & CSUM_LANE_MASK);
+            bytes += sizeof(csum_step);
+        }
+
+        csum += CSUM_FOLD(acc);
+    }
+
+    while (size--)
+        csum += *bytes++;
 
     return csum;
 }
@@ -434,6 +535,119 @@ static uacpi_status get_external_table_header(
     return UACPI_STATUS_OK;
 }
 
+#ifdef UACPI_LAZY_TABLE_HEADERS
+static uacpi_status table_install_pending_unlocked(uacpi_phys_addr phys)
+{
+    uacpi_status ret;
+    struct uacpi_installed_table *tbl;
+    uacpi_size idx;
+
+    ret = table_alloc(&tbl, &idx);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    uacpi_memzero(&tbl->hdr, sizeof(tbl->hdr));
+    tbl->reference_count = 0;
+    tbl->phys_addr = phys;
+    tbl->ptr = UACPI_NULL;
+    tbl->flags = UACPI_TABLE_HEADER_PENDING;
+    tbl->origin = UACPI_TABLE_ORIGIN_FIRMWARE_PHYSICAL;
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status table_set_pending_header_unlocked(
+    struct uacpi_installed_table *tbl, struct acpi_sdt_hdr *hdr
+)
+{
+    tbl->flags &= ~UACPI_TABLE_HEADER_PENDING;
+
+    if (uacpi_unlikely(hdr->length < sizeof(struct acpi_sdt_hdr))) {
+        uacpi_error("invalid table '%.4s' (0x%016"UACPI_PRIX64") size: %u\n",
+                    hdr->signature, UACPI_FMT64(tbl->phys_addr), hdr->length);
+        tbl->flags |= UACPI_TABLE_INVALID;
+        return UACPI_STATUS_INVALID_TABLE_LENGTH;
+    }
+
+    dump_table_header(tbl->phys_addr, hdr);
+    uacpi_memcpy(&tbl->hdr, hdr, sizeof(*hdr));
+
+    // See verify_and_install_table
+    if (uacpi_signatures_match(hdr->signature, ACPI_FACS_SIGNATURE))
+        tbl->flags |= UACPI_TABLE_CSUM_VERIFIED;
+
+    return UACPI_STATUS_OK;
+}
+
+/*
+ * Firmware tends to place its tables right next to each other, so the headers
+ * of pending tables that follow the requested one are read via the same
+ * mapping, as long as they fit into a window of this size.
+ */
+#define PENDING_HEADERS_WINDOW_SIZE (16 * 1024)
+
+/*
+ * Read the header of the table at 'idx' if it was installed via
+ * table_install_pending_unlocked, along with the headers of any pending tables
+ * immediately following it that are located close enough in memory. Tables
+ * whose header cannot be read are marked invalid and are skipped from then on,
+ * exactly like tables with a bad checksum.
+ */
+static void table_resolve_header_unlocked(uacpi_size idx)
+{
+    struct uacpi_installed_table *tbl, *next;
+    struct acpi_sdt_hdr hdr;
+    uacpi_phys_addr start, end;
+    uacpi_size last, size = table_array_size(&tables);
+    uacpi_u8 *virt;
+
+    tbl = table_array_at(&tables, idx);
+    if (!(tbl->flags & UACPI_TABLE_HEADER_PENDING))
+        return;
+
+    start = tbl->phys_addr;
+    end = start + sizeof(hdr);
+
+    for (last = idx + 1; last < size; ++last) {
+        next = table_array_at(&tables, last);
+
+        if (!(next->flags & UACPI_TABLE_HEADER_PENDING) ||
+            next->phys_addr < start ||
+            next->phys_addr + sizeof(hdr) - start > PENDING_HEADERS_WINDOW_SIZE)
+            break;
+
+        end = UACPI_MAX(end, next->phys_addr + sizeof(hdr));
+    }
+
+    virt = uacpi_kernel_map(start, end - start);
+    if (uacpi_unlikely(virt == UACPI_NULL)) {
+        // Try the requested table alone before giving up on it
+        if (last != idx + 1 &&
+            uacpi_likely_success(get_external_table_header(start, &hdr))) {
+            table_set_pending_header_unlocked(tbl, &hdr);
+            return;
+        }
+
+        tbl->flags &= ~UACPI_TABLE_HEADER_PENDING;
+        tbl->flags |= UACPI_TABLE_INVALID;
+        return;
+    }
+
+    for (; idx < last; ++idx) {
+        tbl = table_array_at(&tables, idx);
+
+        uacpi_memcpy(&hdr, virt + (tbl->phys_addr - start), sizeof(hdr));
+        table_set_pending_header_unlocked(tbl, &hdr);
+    }
+
+    uacpi_kernel_unmap(virt, end - start);
+}
+#else
+static void table_resolve_header_unlocked(uacpi_size idx)
+{
+    UACPI_UNUSED(idx);
+}
+#endif
+
 static uacpi_status table_ref_unlocked(struct uacpi_installed_table *tbl)
 {
     switch (tbl->reference_count) {
@@ -803,8 +1017,9 @@ uacpi_status uacpi_for_each_table(
         return ret;
 
     for (idx = base_idx; idx < table_array_size(&tables); ++idx) {
-        tbl = table_array_at(&tables, idx);
+        table_resolve_header_unlocked(idx);
 
+        tbl = table_array_at(&tables, idx);
         if (tbl->flags & UACPI_TABLE_INVALID)
             continue;
 
@@ -1015,9 +1230,12 @@ static uacpi_status table_ctl(uacpi_size idx, struct table_ctl_request *req)
         goto out;
     }
 
+    table_resolve_header_unlocked(idx);
     tbl = table_array_at(&tables, idx);
-    if (uacpi_unlikely(tbl->flags & UACPI_TABLE_INVALID))
-        return UACPI_STATUS_INVALID_ARGUMENT;
+    if (uacpi_unlikely(tbl->flags & UACPI_TABLE_INVALID)) {
+        ret = UACPI_STATUS_INVALID_ARGUMENT;
+        goto out;
+    }
 
     if (req->type & TABLE_CTL_VALIDATE_SET_FLAGS) {
         uacpi_u8 mask = req->expect_set;
@@ -1104,6 +1322,82 @@ void uacpi_table_mark_as_loaded(uacpi_size idx)
     });
 }
 
+static uacpi_bool table_is_physical(struct uacpi_installed_table *tbl)
+{
+    return tbl->origin == UACPI_TABLE_ORIGIN_HOST_PHYSICAL ||
+           tbl->origin == UACPI_TABLE_ORIGIN_FIRMWARE_PHYSICAL;
+}
+
+uacpi_status uacpi_table_prefetch(uacpi_size idx)
+{
+    uacpi_status ret, csum_ret;
+    struct uacpi_installed_table *tbl;
+    uacpi_phys_addr phys_addr;
+    uacpi_u32 length;
+    void *mapping;
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
+
+    ret = uacpi_acquire_native_mutex_may_be_null(table_mutex);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (uacpi_unlikely(table_array_size(&tables) <= idx)) {
+        ret = UACPI_STATUS_INVALID_ARGUMENT;
+        goto out;
+    }
+
+    table_resolve_header_unlocked(idx);
+    tbl = table_array_at(&tables, idx);
+
+    // Already mapped or nothing to verify, just take a reference
+    if (tbl->reference_count != 0 || !table_is_physical(tbl) ||
+        (tbl->flags & (UACPI_TABLE_CSUM_VERIFIED | UACPI_TABLE_INVALID))) {
+        ret = table_ref_unlocked(tbl);
+        goto out;
+    }
+
+    phys_addr = tbl->phys_addr;
+    length = tbl->hdr.length;
+    uacpi_release_native_mutex_may_be_null(table_mutex);
+
+    mapping = uacpi_kernel_map(phys_addr, length);
+    if (uacpi_unlikely(mapping == UACPI_NULL))
+        return UACPI_STATUS_MAPPING_FAILED;
+
+    csum_ret = uacpi_verify_table_checksum(mapping, length);
+
+    ret = uacpi_acquire_native_mutex_may_be_null(table_mutex);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_kernel_unmap(mapping, length);
+        return ret;
+    }
+
+    // The table array might have been reallocated while we weren't looking
+    tbl = table_array_at(&tables, idx);
+
+    if (uacpi_unlikely_error(csum_ret)) {
+        if (!(tbl->flags & UACPI_TABLE_CSUM_VERIFIED))
+            tbl->flags |= UACPI_TABLE_INVALID;
+        ret = csum_ret;
+    } else if (tbl->reference_count == 0) {
+        // Nobody mapped it in the meantime, hand over our mapping
+        tbl->flags |= UACPI_TABLE_CSUM_VERIFIED;
+        tbl->ptr = mapping;
+        tbl->reference_count = 1;
+        mapping = UACPI_NULL;
+    } else {
+        ret = table_ref_unlocked(tbl);
+    }
+
+    if (mapping != UACPI_NULL)
+        uacpi_kernel_unmap(mapping, length);
+
+out:
+    uacpi_release_native_mutex_may_be_null(table_mutex);
+    return ret;
+}
+
 uacpi_status uacpi_table_ref(uacpi_table *tbl)
 {
     return table_ctl(tbl->index, &(struct table_ctl_request) {
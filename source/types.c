@@ -1,4 +1,5 @@
 #include <uacpi/types.h>
+#include <uacpi/platform/config.h>
 #include <uacpi/internal/types.h>
 #include <uacpi/internal/stdlib.h>
 #include <uacpi/internal/shareable.h>
@@ -6,6 +7,7 @@
 #include <uacpi/internal/log.h>
 #include <uacpi/internal/namespace.h>
 #include <uacpi/internal/tables.h>
+#include <uacpi/internal/pool.h>
 #include <uacpi/kernel_api.h>
 
 const uacpi_char *uacpi_object_type_to_string(uacpi_object_type type)
@@ -94,7 +96,7 @@ static uacpi_bool buffer_alloc(uacpi_object *obj, uacpi_size initial_size)
 {
     uacpi_buffer *buf;
 
-    buf = uacpi_kernel_alloc_zeroed(sizeof(uacpi_buffer));
+    buf = uacpi_pool_alloc_zeroed(sizeof(uacpi_buffer));
     if (uacpi_unlikely(buf == UACPI_NULL))
         return UACPI_FALSE;
 
@@ -103,7 +105,7 @@ static uacpi_bool buffer_alloc(uacpi_object *obj, uacpi_size initial_size)
     if (initial_size) {
         buf->data = uacpi_kernel_alloc(initial_size);
         if (uacpi_unlikely(buf->data == UACPI_NULL)) {
-            uacpi_free(buf, sizeof(*buf));
+            uacpi_pool_free(buf, sizeof(*buf));
             return UACPI_FALSE;
         }
 
@@ -129,7 +131,7 @@ uacpi_bool uacpi_package_fill(
     if (uacpi_unlikely(num_elements == 0))
         return UACPI_TRUE;
 
-    pkg->objects = uacpi_kernel_alloc_zeroed(
+    pkg->objects = uacpi_pool_alloc_zeroed(
         num_elements * sizeof(uacpi_handle)
     );
     if (uacpi_unlikely(pkg->objects == UACPI_NULL))
@@ -156,14 +158,14 @@ static uacpi_bool package_alloc(
 {
     uacpi_package *pkg;
 
-    pkg = uacpi_kernel_alloc_zeroed(sizeof(uacpi_package));
+    pkg = uacpi_pool_alloc_zeroed(sizeof(uacpi_package));
     if (uacpi_unlikely(pkg == UACPI_NULL))
         return UACPI_FALSE;
 
     uacpi_shareable_init(pkg);
 
     if (uacpi_unlikely(!uacpi_package_fill(pkg, initial_size, prealloc))) {
-        uacpi_free(pkg, sizeof(*pkg));
+        uacpi_pool_free(pkg, sizeof(*pkg));
         return UACPI_FALSE;
     }
 
@@ -327,7 +329,7 @@ uacpi_object *uacpi_create_object(uacpi_object_type type)
     uacpi_object *ret;
     object_ctor ctor;
 
-    ret = uacpi_kernel_alloc_zeroed(sizeof(*ret));
+    ret = uacpi_pool_alloc_zeroed(sizeof(*ret));
     if (uacpi_unlikely(ret == UACPI_NULL))
         return ret;
 
@@ -339,7 +341,7 @@ uacpi_object *uacpi_create_object(uacpi_object_type type)
         return ret;
 
     if (uacpi_unlikely(!ctor(ret))) {
-        uacpi_free(ret, sizeof(*ret));
+        uacpi_pool_free(ret, sizeof(*ret));
         return UACPI_NULL;
     }
 
@@ -358,7 +360,7 @@ static void free_buffer(uacpi_handle handle)
          */
         uacpi_free(buf->data, UACPI_MAX(buf->size, 1));
 
-    uacpi_free(buf, sizeof(*buf));
+    uacpi_pool_free(buf, sizeof(*buf));
 }
 
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(free_queue, uacpi_package*, 4)
@@ -395,7 +397,7 @@ static void free_plain_no_recurse(uacpi_object *obj, struct free_queue *queue)
         }
 
         // Don't call free_object here as that will recurse
-        uacpi_free(obj, sizeof(*obj));
+        uacpi_pool_free(obj, sizeof(*obj));
         break;
     default:
         /*
@@ -426,7 +428,7 @@ static void unref_chain_no_recurse(uacpi_object *obj, struct free_queue *queue)
             goto do_next;
 
         if (obj->type == UACPI_OBJECT_REFERENCE) {
-            uacpi_free(obj, sizeof(*obj));
+            uacpi_pool_free(obj, sizeof(*obj));
         } else {
             free_plain_no_recurse(obj, queue);
         }
@@ -470,10 +472,10 @@ static void free_package(uacpi_handle handle)
         }
 
         // 2. Release the object array
-        uacpi_free(pkg->objects, sizeof(*pkg->objects) * pkg->count);
+        uacpi_pool_free(pkg->objects, sizeof(*pkg->objects) * pkg->count);
 
         // 3. Release the package itself
-        uacpi_free(pkg, sizeof(*pkg));
+        uacpi_pool_free(pkg, sizeof(*pkg));
     }
 
     free_queue_clear(&queue);
@@ -629,6 +631,15 @@ static void free_method(uacpi_handle handle)
 
     if (!method->native_call && method->owns_code)
        uacpi_free(method->code, method->size);
+    if (method->decode_cache)
+        uacpi_free(
+            method->decode_cache, method->size * sizeof(*method->decode_cache)
+        );
+    if (method->name_cache)
+        uacpi_free(
+            method->name_cache,
+            UACPI_NAME_CACHE_SIZE * sizeof(*method->name_cache)
+        );
     uacpi_free(method, sizeof(*method));
 }
 
@@ -694,7 +705,7 @@ static void free_object_storage(uacpi_object *obj)
 static void free_object(uacpi_object *obj)
 {
     free_object_storage(obj);
-    uacpi_free(obj, sizeof(*obj));
+    uacpi_pool_free(obj, sizeof(*obj));
 }
 
 static void make_chain_bugged(uacpi_object *obj)
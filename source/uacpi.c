@@ -13,6 +13,7 @@
 #include <uacpi/internal/event.h>
 #include <uacpi/internal/notify.h>
 #include <uacpi/internal/osi.h>
+#include <uacpi/internal/pool.h>
 #include <uacpi/internal/registers.h>
 
 struct uacpi_runtime_context g_uacpi_rt_ctx = { 0 };
@@ -259,6 +260,7 @@ uacpi_init_level uacpi_get_current_init_level(void)
 
 void uacpi_state_reset(void)
 {
+    uacpi_deinitialize_utilities();
     uacpi_deinitialize_namespace();
     uacpi_deinitialize_interfaces();
     uacpi_deinitialize_events();
@@ -266,6 +268,7 @@ void uacpi_state_reset(void)
     uacpi_deinitialize_opregion();
     uacpi_deininitialize_registers();
     uacpi_deinitialize_tables();
+    uacpi_deinitialize_interpreter();
 
 #ifndef UACPI_REDUCED_HARDWARE
     if (g_uacpi_rt_ctx.was_in_legacy_mode)
@@ -277,6 +280,7 @@ void uacpi_state_reset(void)
 #endif
 
     uacpi_memzero(&g_uacpi_rt_ctx, sizeof(g_uacpi_rt_ctx));
+    uacpi_deinitialize_pools();
 
 #ifdef UACPI_KERNEL_INITIALIZATION
     uacpi_kernel_deinitialize();
@@ -309,13 +313,21 @@ uacpi_status uacpi_initialize(uacpi_u64 flags)
     if (g_uacpi_rt_ctx.max_call_stack_depth == 0)
         uacpi_context_set_max_call_stack_depth(UACPI_DEFAULT_MAX_CALL_STACK_DEPTH);
 
+    ret = uacpi_initialize_pools();
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
+    ret = uacpi_initialize_interpreter();
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
     ret = uacpi_initialize_tables();
     if (uacpi_unlikely_error(ret))
         goto out_fatal_error;
 
     ret = uacpi_ininitialize_registers();
     if (uacpi_unlikely_error(ret))
-        return ret;
+        goto out_fatal_error;
 
     ret = uacpi_initialize_events_early();
     if (uacpi_unlikely_error(ret))
@@ -337,6 +349,10 @@ uacpi_status uacpi_initialize(uacpi_u64 flags)
     if (uacpi_unlikely_error(ret))
         goto out_fatal_error;
 
+    ret = uacpi_initialize_utilities();
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
     uacpi_install_default_address_space_handlers();
 
     if (!uacpi_check_flag(UACPI_FLAG_NO_ACPI_MODE))
@@ -379,6 +395,202 @@ static uacpi_u64 elapsed_ms(uacpi_u64 begin_ns, uacpi_u64 end_ns)
     return (end_ns - begin_ns) / (1000ull * 1000ull);
 }
 
+#if defined(UACPI_PARALLEL_TABLE_LOAD) || \
+    defined(UACPI_PARALLEL_NAMESPACE_INIT)
+
+/*
+ * Tracks completion of a group of work items scheduled via
+ * uacpi_kernel_schedule_work. The scheduling thread holds a reference of its
+ * own, which is dropped by work_group_wait.
+ */
+struct work_group {
+    uacpi_u32 pending;
+
+    /*
+     * Set by the last work item once it's done signaling 'done_event'. This is
+     * the very last access a work item makes to any memory owned by the
+     * scheduling thread, so neither the event nor the group may be released
+     * until it's observed.
+     */
+    uacpi_u32 signaled;
+    uacpi_handle done_event;
+};
+
+static uacpi_status work_group_init(struct work_group *grp)
+{
+    grp->done_event = uacpi_kernel_create_event();
+    if (uacpi_unlikely(grp->done_event == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    grp->pending = 1;
+    grp->signaled = 0;
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status work_group_schedule(
+    struct work_group *grp, uacpi_work_type type,
+    uacpi_work_handler handler, uacpi_handle ctx
+)
+{
+    uacpi_status ret;
+
+    uacpi_atomic_inc32(&grp->pending);
+
+    ret = uacpi_kernel_schedule_work(type, handler, ctx);
+    if (uacpi_unlikely_error(ret))
+        uacpi_atomic_dec32(&grp->pending);
+
+    return ret;
+}
+
+// Must be the last thing a work item does
+static void work_group_item_done(struct work_group *grp)
+{
+    uacpi_handle done_event = grp->done_event;
+
+    if (uacpi_atomic_dec32(&grp->pending) != 0)
+        return;
+
+    uacpi_kernel_signal_event(done_event);
+    uacpi_atomic_store32(&grp->signaled, 1);
+}
+
+static void work_group_wait(struct work_group *grp)
+{
+    if (uacpi_atomic_dec32(&grp->pending) != 0) {
+        while (!uacpi_kernel_wait_for_event(grp->done_event, 0xFFFF))
+            ;
+
+        while (!uacpi_atomic_load32(&grp->signaled))
+            UACPI_ARCH_SPIN_LOOP_HINT();
+    }
+
+    uacpi_kernel_free_event(grp->done_event);
+    grp->done_event = UACPI_NULL;
+}
+#endif
+
+#ifdef UACPI_PARALLEL_TABLE_LOAD
+
+struct table_prefetch_entry {
+    uacpi_size idx;
+    uacpi_bool referenced;
+};
+
+struct table_prefetch_ctx {
+    struct table_prefetch_entry *entries;
+    uacpi_u32 num_entries;
+    uacpi_u32 next_entry;
+
+    struct work_group workers;
+};
+
+static uacpi_iteration_decision collect_table_to_prefetch(
+    void *opaque, struct uacpi_installed_table *tbl, uacpi_size idx
+)
+{
+    struct table_prefetch_ctx *ctx = opaque;
+
+    if (!match_ssdt_or_psdt(tbl))
+        return UACPI_ITERATION_DECISION_CONTINUE;
+
+    if (ctx->entries != UACPI_NULL)
+        ctx->entries[ctx->next_entry++].idx = idx;
+    else
+        ctx->num_entries++;
+
+    if (ctx->entries != UACPI_NULL && ctx->next_entry == ctx->num_entries)
+        return UACPI_ITERATION_DECISION_BREAK;
+    return UACPI_ITERATION_DECISION_CONTINUE;
+}
+
+static void table_prefetch_work(uacpi_handle opaque)
+{
+    struct table_prefetch_ctx *ctx = opaque;
+    struct table_prefetch_entry *entry;
+    uacpi_u32 i;
+
+    for (;;) {
+        i = uacpi_atomic_inc32(&ctx->next_entry) - 1;
+        if (i >= ctx->num_entries)
+            break;
+
+        entry = &ctx->entries[i];
+        entry->referenced = uacpi_table_prefetch(entry->idx) == UACPI_STATUS_OK;
+    }
+
+    work_group_item_done(&ctx->workers);
+}
+
+/*
+ * Start mapping & verifying all SSDTs/PSDTs installed so far in the
+ * background, so that by the time the main thread gets to loading a table,
+ * the only thing left to do is executing its definition block.
+ */
+static void table_prefetch_start(struct table_prefetch_ctx *ctx)
+{
+    uacpi_status ret;
+    uacpi_u32 i;
+
+    uacpi_for_each_table(0, collect_table_to_prefetch, ctx);
+    if (ctx->num_entries == 0)
+        return;
+
+    ctx->entries = uacpi_kernel_alloc_zeroed(
+        ctx->num_entries * sizeof(*ctx->entries)
+    );
+    if (uacpi_unlikely(ctx->entries == UACPI_NULL))
+        goto out_no_prefetch;
+
+    uacpi_for_each_table(0, collect_table_to_prefetch, ctx);
+    ctx->num_entries = ctx->next_entry;
+    ctx->next_entry = 0;
+
+    ret = work_group_init(&ctx->workers);
+    if (uacpi_unlikely_error(ret))
+        goto out_no_prefetch;
+
+    for (i = 0; i < UACPI_TABLE_LOAD_WORKERS && i < ctx->num_entries; ++i) {
+        ret = work_group_schedule(
+            &ctx->workers, UACPI_WORK_TABLE_PREFETCH, table_prefetch_work, ctx
+        );
+        if (uacpi_unlikely_error(ret))
+            break;
+    }
+
+    return;
+
+out_no_prefetch:
+    if (ctx->entries != UACPI_NULL) {
+        uacpi_free(ctx->entries, ctx->num_entries * sizeof(*ctx->entries));
+        ctx->entries = UACPI_NULL;
+    }
+    ctx->num_entries = 0;
+}
+
+static void table_prefetch_finish(struct table_prefetch_ctx *ctx)
+{
+    uacpi_table tbl;
+    uacpi_u32 i;
+
+    if (ctx->entries == UACPI_NULL)
+        return;
+
+    work_group_wait(&ctx->workers);
+
+    for (i = 0; i < ctx->num_entries; ++i) {
+        if (!ctx->entries[i].referenced)
+            continue;
+
+        tbl.index = ctx->entries[i].idx;
+        uacpi_table_unref(&tbl);
+    }
+
+    uacpi_free(ctx->entries, ctx->num_entries * sizeof(*ctx->entries));
+    ctx->entries = UACPI_NULL;
+}
+#endif
+
 uacpi_status uacpi_namespace_load(void)
 {
     struct uacpi_table tbl;
@@ -386,6 +598,9 @@ uacpi_status uacpi_namespace_load(void)
     uacpi_u64 begin_ts, end_ts;
     struct table_load_stats st = { 0 };
     uacpi_size cur_index;
+#ifdef UACPI_PARALLEL_TABLE_LOAD
+    struct table_prefetch_ctx prefetch = { 0 };
+#endif
 
     UACPI_ENSURE_INIT_LEVEL_IS(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
 
@@ -403,6 +618,10 @@ uacpi_status uacpi_namespace_load(void)
         goto out_fatal_error;
     }
 
+#ifdef UACPI_PARALLEL_TABLE_LOAD
+    table_prefetch_start(&prefetch);
+#endif
+
     ret = uacpi_table_load_with_cause(tbl.index, UACPI_TABLE_LOAD_CAUSE_INIT);
     if (uacpi_unlikely_error(ret)) {
         trace_table_load_failure(tbl.hdr, UACPI_LOG_ERROR, ret);
@@ -429,6 +648,10 @@ uacpi_status uacpi_namespace_load(void)
         uacpi_table_unref(&tbl);
     }
 
+#ifdef UACPI_PARALLEL_TABLE_LOAD
+    table_prefetch_finish(&prefetch);
+#endif
+
     end_ts = uacpi_kernel_get_nanoseconds_since_boot();
 
     if (uacpi_unlikely(st.failure_counter != 0)) {
@@ -465,10 +688,24 @@ uacpi_status uacpi_namespace_load(void)
     return UACPI_STATUS_OK;
 
 out_fatal_error:
+#ifdef UACPI_PARALLEL_TABLE_LOAD
+    table_prefetch_finish(&prefetch);
+#endif
     uacpi_state_reset();
     return ret;
 }
 
+static uacpi_status do_eval(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    const uacpi_object_array *args, uacpi_object **out_obj,
+    uacpi_bool shared_only
+);
+static uacpi_status do_eval_typed(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    const uacpi_object_array *args, uacpi_object_type_bits ret_mask,
+    uacpi_object **out_obj, uacpi_bool shared_only
+);
+
 struct ns_init_context {
     uacpi_size ini_executed;
     uacpi_size ini_errors;
@@ -476,14 +713,52 @@ struct ns_init_context {
     uacpi_size sta_errors;
     uacpi_size devices;
     uacpi_size thermal_zones;
+
+#ifdef UACPI_PARALLEL_NAMESPACE_INIT
+    /*
+     * Set while initializing a subtree on a worker. Methods are then only
+     * ever run with the namespace read lock held, and 'denied' is set instead
+     * of falling back to exclusive execution.
+     */
+    uacpi_bool shared_only;
+    uacpi_bool denied;
+#endif
 };
 
+static uacpi_bool ns_init_shared_only(struct ns_init_context *ctx)
+{
+#ifdef UACPI_PARALLEL_NAMESPACE_INIT
+    return ctx->shared_only;
+#else
+    UACPI_UNUSED(ctx);
+    return UACPI_FALSE;
+#endif
+}
+
+static uacpi_bool ns_init_was_denied(
+    struct ns_init_context *ctx, uacpi_status ret
+)
+{
+#ifdef UACPI_PARALLEL_NAMESPACE_INIT
+    if (ctx->shared_only && ret == UACPI_STATUS_DENIED)
+        ctx->denied = UACPI_TRUE;
+
+    return ctx->denied;
+#else
+    UACPI_UNUSED(ctx);
+    UACPI_UNUSED(ret);
+    return UACPI_FALSE;
+#endif
+}
+
 static void ini_eval(struct ns_init_context *ctx, uacpi_namespace_node *node)
 {
     uacpi_status ret;
 
-    ret = uacpi_eval(node, "_INI", UACPI_NULL, UACPI_NULL);
-    if (ret == UACPI_STATUS_NOT_FOUND)
+    ret = do_eval(
+        node, "_INI", UACPI_NULL, UACPI_NULL, ns_init_shared_only(ctx)
+    );
+    if (ret == UACPI_STATUS_NOT_FOUND || ns_init_was_denied(ctx, ret))
         return;
 
     ctx->ini_executed++;
@@ -497,9 +772,28 @@ static uacpi_status sta_eval(
 )
 {
     uacpi_status ret;
+    uacpi_object *obj;
 
-    ret = uacpi_eval_sta(node, value);
-    if (*value == 0xFFFFFFFF)
+    if (!ns_init_shared_only(ctx)) {
+        ret = uacpi_eval_sta(node, value);
+    } else {
+        // Same as uacpi_eval_sta, except that it never takes the write lock
+        ret = do_eval_typed(
+            node, "_STA", UACPI_NULL, UACPI_OBJECT_INTEGER_BIT, &obj,
+            UACPI_TRUE
+        );
+        if (ret == UACPI_STATUS_NOT_FOUND) {
+            *value = 0xFFFFFFFF;
+            ret = UACPI_STATUS_OK;
+        } else if (uacpi_likely_success(ret)) {
+            *value = obj->integer;
+            uacpi_object_unref(obj);
+        } else {
+            *value = 0;
+        }
+    }
+
+    if (*value == 0xFFFFFFFF || ns_init_was_denied(ctx, ret))
         return ret;
 
     ctx->sta_executed++;
@@ -539,6 +833,8 @@ static uacpi_iteration_decision do_sta_ini(
     }
 
     ret = sta_eval(ctx, node, &sta_ret);
+    if (ns_init_was_denied(ctx, ret))
+        return UACPI_ITERATION_DECISION_BREAK;
     if (uacpi_unlikely_error(ret))
         return UACPI_ITERATION_DECISION_CONTINUE;
 
@@ -559,10 +855,251 @@ static uacpi_iteration_decision do_sta_ini(
     }
 
     ini_eval(ctx, node);
+    if (ns_init_was_denied(ctx, UACPI_STATUS_OK))
+        return UACPI_ITERATION_DECISION_BREAK;
 
     return UACPI_ITERATION_DECISION_CONTINUE;
 }
 
+#ifdef UACPI_PARALLEL_NAMESPACE_INIT
+
+struct ns_init_subtree {
+    uacpi_namespace_node *node;
+
+    // Statistics of the speculative run, only merged if it's kept
+    struct ns_init_context ctx;
+};
+
+struct ns_init_shared {
+    // Direct children of \_SB, in walk order
+    struct ns_init_subtree *subtrees;
+    uacpi_u32 num_subtrees;
+    uacpi_u32 next_subtree;
+
+    /*
+     * Index of the first subtree that ran into a method requiring exclusive
+     * execution. This subtree and all the ones after it are initialized again
+     * from scratch, serially and in walk order, once all workers are done.
+     */
+    uacpi_u32 first_ordered;
+
+    struct work_group group;
+    uacpi_bool have_group;
+};
+
+static void init_subtree(
+    struct ns_init_context *ctx, uacpi_namespace_node *node
+)
+{
+    if (do_sta_ini(ctx, node, 1) != UACPI_ITERATION_DECISION_CONTINUE)
+        return;
+
+    uacpi_namespace_for_each_child(
+        node, do_sta_ini, UACPI_NULL,
+        UACPI_OBJECT_ANY_BIT, UACPI_MAX_DEPTH_ANY, ctx
+    );
+}
+
+static void ns_init_mark_ordered(struct ns_init_shared *shared, uacpi_u32 idx)
+{
+    uacpi_u32 cur = uacpi_atomic_load32(&shared->first_ordered);
+
+    while (idx < cur &&
+           !uacpi_atomic_cmpxchg32(&shared->first_ordered, &cur, idx));
+}
+
+/*
+ * Subtrees are handed out in walk order and initialized with shared-only
+ * execution, so nothing done here has any side effects. A subtree is only kept
+ * if it, and every subtree preceding it, ran to completion this way: all of
+ * them only read global state, so their relative order doesn't matter.
+ */
+static void init_subtrees_speculatively(struct ns_init_shared *shared)
+{
+    struct ns_init_subtree *subtree;
+    uacpi_u32 idx;
+
+    for (;;) {
+        idx = uacpi_atomic_inc32(&shared->next_subtree) - 1;
+        if (idx >= shared->num_subtrees ||
+            idx >= uacpi_atomic_load32(&shared->first_ordered))
+            return;
+
+        subtree = &shared->subtrees[idx];
+        subtree->ctx.shared_only = UACPI_TRUE;
+        init_subtree(&subtree->ctx, subtree->node);
+
+        if (subtree->ctx.denied) {
+            ns_init_mark_ordered(shared, idx);
+            return;
+        }
+    }
+}
+
+static void ns_init_work(uacpi_handle opaque)
+{
+    struct ns_init_shared *shared = opaque;
+
+    init_subtrees_speculatively(shared);
+    work_group_item_done(&shared->group);
+}
+
+static void ns_init_context_merge(
+    struct ns_init_context *dst, const struct ns_init_context *src
+)
+{
+    dst->ini_executed += src->ini_executed;
+    dst->ini_errors += src->ini_errors;
+    dst->sta_executed += src->sta_executed;
+    dst->sta_errors += src->sta_errors;
+    dst->devices += src->devices;
+    dst->thermal_zones += src->thermal_zones;
+}
+
+static uacpi_status collect_sb_subtrees(struct ns_init_shared *shared)
+{
+    uacpi_namespace_node *sb, *node;
+    uacpi_status ret;
+    uacpi_u32 i = 0;
+
+    sb = uacpi_namespace_get_predefined(UACPI_PREDEFINED_NAMESPACE_SB);
+
+    ret = uacpi_namespace_read_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    for (node = sb->child; node; node = node->next)
+        shared->num_subtrees++;
+
+    if (shared->num_subtrees == 0)
+        goto out;
+
+    shared->subtrees = uacpi_kernel_alloc_zeroed(
+        shared->num_subtrees * sizeof(*shared->subtrees)
+    );
+    if (uacpi_unlikely(shared->subtrees == UACPI_NULL)) {
+        shared->num_subtrees = 0;
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    // Keep the nodes alive in case some _INI decides to unload a table
+    for (node = sb->child; node; node = node->next) {
+        uacpi_shareable_ref(node);
+        shared->subtrees[i++].node = node;
+    }
+
+out:
+    uacpi_namespace_read_unlock();
+    return ret;
+}
+
+/*
+ * \_SB itself is initialized first, after which the subtrees rooted at each of
+ * its direct children are handed out to workers one by one, see
+ * init_subtrees_speculatively.
+ */
+static void parallel_sta_ini_sb(
+    struct ns_init_context *ctx, uacpi_namespace_node *sb
+)
+{
+    struct ns_init_shared shared = { 0 };
+    uacpi_u32 i;
+    uacpi_status ret;
+
+    if (do_sta_ini(ctx, sb, 1) != UACPI_ITERATION_DECISION_CONTINUE)
+        return;
+
+    ret = collect_sb_subtrees(&shared);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_warn(
+            "unable to collect \\_SB subtrees (%s), "
+            "falling back to serial initialization\n",
+            uacpi_status_to_string(ret)
+        );
+        uacpi_namespace_for_each_child(
+            sb, do_sta_ini, UACPI_NULL,
+            UACPI_OBJECT_ANY_BIT, UACPI_MAX_DEPTH_ANY, ctx
+        );
+        return;
+    }
+
+    shared.first_ordered = shared.num_subtrees;
+
+    if (shared.num_subtrees > 1) {
+        ret = work_group_init(&shared.group);
+        shared.have_group = uacpi_likely_success(ret);
+    }
+
+    if (shared.have_group) {
+        for (i = 0; i < UACPI_NAMESPACE_INIT_WORKERS &&
+                    i < shared.num_subtrees - 1; ++i) {
+            ret = work_group_schedule(
+                &shared.group, UACPI_WORK_NAMESPACE_INITIALIZATION,
+                ns_init_work, &shared
+            );
+            if (uacpi_unlikely_error(ret))
+                break;
+        }
+
+        init_subtrees_speculatively(&shared);
+        work_group_wait(&shared.group);
+    } else {
+        shared.first_ordered = 0;
+    }
+
+    for (i = 0; i < shared.first_ordered; ++i)
+        ns_init_context_merge(ctx, &shared.subtrees[i].ctx);
+
+    if (shared.have_group && shared.first_ordered < shared.num_subtrees) {
+        uacpi_trace(
+            "AML requires ordered device initialization, evaluating the "
+            "remaining %u \\_SB subtrees serially\n",
+            shared.num_subtrees - shared.first_ordered
+        );
+    }
+
+    for (i = shared.first_ordered; i < shared.num_subtrees; ++i)
+        init_subtree(ctx, shared.subtrees[i].node);
+
+    for (i = 0; i < shared.num_subtrees; ++i)
+        uacpi_namespace_node_unref(shared.subtrees[i].node);
+
+    if (shared.subtrees != UACPI_NULL) {
+        uacpi_free(
+            shared.subtrees, shared.num_subtrees * sizeof(*shared.subtrees)
+        );
+    }
+}
+
+static uacpi_iteration_decision do_sta_ini_parallel_sb(
+    void *opaque, uacpi_namespace_node *node, uacpi_u32 depth
+)
+{
+    if (node != uacpi_namespace_get_predefined(UACPI_PREDEFINED_NAMESPACE_SB))
+        return do_sta_ini(opaque, node, depth);
+
+    parallel_sta_ini_sb(opaque, node);
+
+    // The entire \_SB subtree is done, move on to whatever follows it
+    return UACPI_ITERATION_DECISION_NEXT_PEER;
+}
+
+/*
+ * The namespace is walked in the same order as with serial initialization,
+ * except that the \_SB subtree is initialized via parallel_sta_ini_sb as soon
+ * as the walk reaches it. Nodes preceding \_SB are thus still initialized
+ * before it, and its peers that come after it only once it's fully done.
+ */
+static void parallel_sta_ini(struct ns_init_context *ctx)
+{
+    uacpi_namespace_for_each_child(
+        uacpi_namespace_root(), do_sta_ini_parallel_sb, UACPI_NULL,
+        UACPI_OBJECT_ANY_BIT, UACPI_MAX_DEPTH_ANY, ctx
+    );
+}
+#endif
+
 uacpi_status uacpi_namespace_initialize(void)
 {
     struct ns_init_context ctx = { 0 };
@@ -615,10 +1152,14 @@ uacpi_status uacpi_namespace_initialize(void)
     }
 
     // Step 4 - Run all other _STA and _INI methods
+#ifdef UACPI_PARALLEL_NAMESPACE_INIT
+    parallel_sta_ini(&ctx);
+#else
     uacpi_namespace_for_each_child(
         root, do_sta_ini, UACPI_NULL,
         UACPI_OBJECT_ANY_BIT, UACPI_MAX_DEPTH_ANY, &ctx
     );
+#endif
 
     end_ts = uacpi_kernel_get_nanoseconds_since_boot();
 
@@ -645,9 +1186,15 @@ out:
     return ret;
 }
 
-uacpi_status uacpi_eval(
+/*
+ * If 'shared_only' is set, methods that can't complete with only the namespace
+ * read lock held are not retried with the write lock, UACPI_STATUS_DENIED is
+ * returned instead.
+ */
+static uacpi_status do_eval(
     uacpi_namespace_node *parent, const uacpi_char *path,
-    const uacpi_object_array *args, uacpi_object **out_obj
+    const uacpi_object_array *args, uacpi_object **out_obj,
+    uacpi_bool shared_only
 )
 {
     struct uacpi_namespace_node *node;
@@ -708,13 +1255,35 @@ uacpi_status uacpi_eval(
 
     method = obj->method;
     uacpi_shareable_ref(method);
+
+#ifndef UACPI_EXCLUSIVE_METHOD_EXECUTION
+    /*
+     * Try running the method under the read lock first, this only fails if it
+     * attempts to modify global state, in which case it's restarted below.
+     */
+    if (!method->needs_exclusive_execution) {
+        ret = uacpi_execute_control_method_shared(
+            node, method, args, out_obj
+        );
+        if (ret != UACPI_STATUS_DENIED) {
+            uacpi_namespace_read_unlock();
+            goto out_no_write_lock;
+        }
+    }
+#endif
     uacpi_namespace_read_unlock();
 
+    if (shared_only) {
+        ret = UACPI_STATUS_DENIED;
+        goto out_no_write_lock;
+    }
+
     // Upgrade to a write-lock since we're about to run a method
     ret = uacpi_namespace_write_lock();
     if (uacpi_unlikely_error(ret))
         goto out_no_write_lock;
 
+    method->needs_exclusive_execution = 1;
     ret = uacpi_execute_control_method(node, method, args, out_obj);
     uacpi_namespace_write_unlock();
 
@@ -723,6 +1292,243 @@ out_no_write_lock:
     return ret;
 }
 
+uacpi_status uacpi_eval(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    const uacpi_object_array *args, uacpi_object **out_obj
+)
+{
+    return do_eval(parent, path, args, out_obj, UACPI_FALSE);
+}
+
+struct eval_batch_path {
+    const uacpi_char *path;
+
+    // Set if 'path' is a single relative name segment, which is the case
+    // for pretty much every batch evaluation, e.g. "_STA" or "_ADR".
+    uacpi_bool is_single_nameseg;
+    uacpi_object_name nameseg;
+};
+
+static void eval_batch_path_init(
+    struct eval_batch_path *bp, const uacpi_char *path
+)
+{
+    uacpi_size i, length;
+
+    bp->path = path;
+    bp->is_single_nameseg = UACPI_FALSE;
+
+    if (path == UACPI_NULL)
+        return;
+
+    length = uacpi_strlen(path);
+    if (length == 0 || length > sizeof(bp->nameseg))
+        return;
+
+    for (i = 0; i < sizeof(bp->nameseg); ++i) {
+        if (i >= length) {
+            bp->nameseg.text[i] = '_';
+            continue;
+        }
+
+        switch (path[i]) {
+        case '\\':
+        case '^':
+        case '.':
+            return;
+        default:
+            bp->nameseg.text[i] = path[i];
+        }
+    }
+
+    bp->is_single_nameseg = UACPI_TRUE;
+}
+
+static uacpi_status eval_batch_resolve(
+    uacpi_namespace_node *parent, const struct eval_batch_path *bp,
+    uacpi_namespace_node **out_node
+)
+{
+    uacpi_namespace_node *node;
+
+    if (uacpi_unlikely(parent == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    if (bp->path == UACPI_NULL) {
+        *out_node = parent;
+        return UACPI_STATUS_OK;
+    }
+
+    if (!bp->is_single_nameseg) {
+        return uacpi_namespace_node_resolve(
+            parent, bp->path, UACPI_SHOULD_LOCK_NO,
+            UACPI_MAY_SEARCH_ABOVE_PARENT_NO, UACPI_PERMANENT_ONLY_YES,
+            out_node
+        );
+    }
+
+    node = uacpi_namespace_node_find_sub_node(parent, bp->nameseg);
+    if (node == UACPI_NULL)
+        return UACPI_STATUS_NOT_FOUND;
+    if (uacpi_unlikely(uacpi_namespace_node_is_temporary(node)))
+        return UACPI_STATUS_DENIED;
+
+    *out_node = node;
+    return UACPI_STATUS_OK;
+}
+
+/*
+ * Evaluate one batch entry under the read lock. Returns UACPI_STATUS_DENIED
+ * if the entry must be re-evaluated with the write lock held.
+ */
+static uacpi_status eval_batch_one_shared(
+    uacpi_namespace_node *parent, const struct eval_batch_path *bp,
+    const uacpi_object_array *args, uacpi_object **out_obj
+)
+{
+    uacpi_namespace_node *node;
+#ifndef UACPI_EXCLUSIVE_METHOD_EXECUTION
+    uacpi_control_method *method;
+#endif
+    uacpi_object *obj;
+    uacpi_status ret;
+
+    ret = eval_batch_resolve(parent, bp, &node);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    obj = uacpi_namespace_node_get_object(node);
+    if (uacpi_unlikely(obj == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    if (obj->type != UACPI_OBJECT_METHOD) {
+        uacpi_object *new_obj;
+
+        if (out_obj == UACPI_NULL)
+            return UACPI_STATUS_OK;
+
+        new_obj = uacpi_create_object(UACPI_OBJECT_UNINITIALIZED);
+        if (uacpi_unlikely(new_obj == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+
+        ret = uacpi_object_assign(
+            new_obj, obj, UACPI_ASSIGN_BEHAVIOR_DEEP_COPY
+        );
+        if (uacpi_unlikely_error(ret)) {
+            uacpi_object_unref(new_obj);
+            return ret;
+        }
+
+        *out_obj = new_obj;
+        return ret;
+    }
+
+#ifdef UACPI_EXCLUSIVE_METHOD_EXECUTION
+    UACPI_UNUSED(args);
+    return UACPI_STATUS_DENIED;
+#else
+    method = obj->method;
+    if (method->needs_exclusive_execution)
+        return UACPI_STATUS_DENIED;
+
+    uacpi_shareable_ref(method);
+    ret = uacpi_execute_control_method_shared(node, method, args, out_obj);
+    uacpi_method_unref(method);
+    return ret;
+#endif
+}
+
+// Same as above, but with the write lock held
+static uacpi_status eval_batch_one_exclusive(
+    uacpi_namespace_node *parent, const struct eval_batch_path *bp,
+    const uacpi_object_array *args, uacpi_object **out_obj
+)
+{
+    uacpi_namespace_node *node;
+    uacpi_control_method *method;
+    uacpi_object *obj;
+    uacpi_status ret;
+
+    ret = eval_batch_resolve(parent, bp, &node);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    obj = uacpi_namespace_node_get_object_typed(
+        node, UACPI_OBJECT_METHOD_BIT
+    );
+
+    // Got replaced by a plain object while we weren't holding the lock
+    if (uacpi_unlikely(obj == UACPI_NULL))
+        return eval_batch_one_shared(parent, bp, args, out_obj);
+
+    method = obj->method;
+    uacpi_shareable_ref(method);
+    method->needs_exclusive_execution = 1;
+    ret = uacpi_execute_control_method(node, method, args, out_obj);
+    uacpi_method_unref(method);
+    return ret;
+}
+
+uacpi_status uacpi_eval_batch(
+    uacpi_namespace_node *const *parents, uacpi_size count,
+    const uacpi_char *path, const uacpi_object_array *args,
+    uacpi_status *out_statuses, uacpi_object **out_objs
+)
+{
+    struct eval_batch_path bp;
+    uacpi_size i;
+    uacpi_status ret;
+
+    if (uacpi_unlikely(parents == UACPI_NULL || out_statuses == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    eval_batch_path_init(&bp, path);
+
+    if (out_objs != UACPI_NULL)
+        uacpi_memzero(out_objs, count * sizeof(*out_objs));
+
+    ret = uacpi_namespace_read_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    for (i = 0; i < count; ++i) {
+        out_statuses[i] = eval_batch_one_shared(
+            parents[i], &bp, args, out_objs ? &out_objs[i] : UACPI_NULL
+        );
+        if (out_statuses[i] == UACPI_STATUS_DENIED)
+            break;
+    }
+
+    uacpi_namespace_read_unlock();
+
+    if (i == count)
+        return ret;
+
+    /*
+     * Entry 'i' needs exclusive access. It and everything after it is
+     * evaluated with the write lock held, still in order, so that later
+     * entries observe its side effects just like with separate uacpi_eval()
+     * calls.
+     */
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    for (; i < count; ++i) {
+        uacpi_object **out_obj = out_objs ? &out_objs[i] : UACPI_NULL;
+
+        out_statuses[i] = eval_batch_one_shared(parents[i], &bp, args, out_obj);
+        if (out_statuses[i] == UACPI_STATUS_DENIED) {
+            out_statuses[i] = eval_batch_one_exclusive(
+                parents[i], &bp, args, out_obj
+            );
+        }
+    }
+
+    uacpi_namespace_write_unlock();
+    return ret;
+}
+
 uacpi_status uacpi_eval_simple(
     uacpi_namespace_node *parent, const uacpi_char *path, uacpi_object **ret
 )
@@ -790,10 +1596,10 @@ static void trace_invalid_return_type(
         uacpi_free_dynamic_string(abs_path);
 }
 
-uacpi_status uacpi_eval_typed(
+static uacpi_status do_eval_typed(
     uacpi_namespace_node *parent, const uacpi_char *path,
     const uacpi_object_array *args, uacpi_object_type_bits ret_mask,
-    uacpi_object **out_obj
+    uacpi_object **out_obj, uacpi_bool shared_only
 )
 {
     uacpi_status ret;
@@ -803,7 +1609,7 @@ uacpi_status uacpi_eval_typed(
     if (uacpi_unlikely(out_obj == UACPI_NULL))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
-    ret = uacpi_eval(parent, path, args, &obj);
+    ret = do_eval(parent, path, args, &obj, shared_only);
     if (uacpi_unlikely_error(ret))
         return ret;
 
@@ -820,6 +1626,15 @@ uacpi_status uacpi_eval_typed(
     return UACPI_STATUS_OK;
 }
 
+uacpi_status uacpi_eval_typed(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    const uacpi_object_array *args, uacpi_object_type_bits ret_mask,
+    uacpi_object **out_obj
+)
+{
+    return do_eval_typed(parent, path, args, ret_mask, out_obj, UACPI_FALSE);
+}
+
 uacpi_status uacpi_eval_simple_typed(
     uacpi_namespace_node *parent, const uacpi_char *path,
     uacpi_object_type_bits ret_mask, uacpi_object **ret
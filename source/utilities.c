@@ -6,6 +6,9 @@
 #include <uacpi/internal/utilities.h>
 #include <uacpi/internal/log.h>
 #include <uacpi/internal/namespace.h>
+#include <uacpi/internal/dynamic_array.h>
+#include <uacpi/internal/mutex.h>
+#include <uacpi/platform/atomic.h>
 
 void uacpi_eisa_id_to_string(uacpi_u32 id, uacpi_char *out_string)
 {
@@ -951,6 +954,415 @@ static uacpi_iteration_decision find_one_device(
 }
 
 
+#ifdef UACPI_PNP_ID_INDEX
+/*
+ * An index of devices by every ID they report via _HID & _CID. Only 32-bit
+ * hashes of the IDs are stored, as every candidate is re-matched with
+ * uacpi_device_matches_pnp_id() before being reported anyway. Entries are
+ * stored in namespace walk order, so lower entry indices always come first
+ * in a uacpi_namespace_for_each_child() walk.
+ */
+#define PNP_ID_INDEX_END 0xFFFFFFFF
+#define PNP_ID_INDEX_MIN_BUCKETS 16
+
+struct pnp_id_index_entry {
+    uacpi_namespace_node *node;
+    uacpi_u32 hash;
+    uacpi_u32 next;
+};
+
+struct pnp_id_index {
+    struct pnp_id_index_entry *entries;
+    uacpi_u32 num_entries;
+    uacpi_u32 *buckets;
+    uacpi_u32 num_buckets;
+    uacpi_u32 generation;
+};
+
+static uacpi_handle pnp_id_index_mutex;
+static struct pnp_id_index *pnp_id_index;
+
+// The index is only valid if built at this generation
+static uacpi_u32 pnp_id_index_generation;
+
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE(
+    pnp_id_entry_array, struct pnp_id_index_entry, 32
+)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+    pnp_id_entry_array, struct pnp_id_index_entry, static
+)
+
+static uacpi_u32 pnp_id_hash(const uacpi_char *id)
+{
+    uacpi_u32 hash = 0x811C9DC5;
+
+    while (*id)
+        hash = (hash ^ (uacpi_u8)*id++) * 0x01000193;
+
+    return hash;
+}
+
+static void pnp_id_index_free(struct pnp_id_index *index)
+{
+    uacpi_u32 i;
+
+    if (index == UACPI_NULL)
+        return;
+
+    for (i = 0; i < index->num_entries; ++i)
+        uacpi_namespace_node_unref(index->entries[i].node);
+
+    if (index->entries != UACPI_NULL)
+        uacpi_free(index->entries, sizeof(*index->entries) * index->num_entries);
+    if (index->buckets != UACPI_NULL)
+        uacpi_free(index->buckets, sizeof(*index->buckets) * index->num_buckets);
+    uacpi_free(index, sizeof(*index));
+}
+
+struct pnp_id_index_build_ctx {
+    struct pnp_id_entry_array entries;
+    uacpi_status status;
+};
+
+static uacpi_bool pnp_id_index_add(
+    struct pnp_id_index_build_ctx *ctx, uacpi_namespace_node *node,
+    const uacpi_char *id
+)
+{
+    struct pnp_id_index_entry *entry;
+
+    entry = pnp_id_entry_array_alloc(&ctx->entries);
+    if (uacpi_unlikely(entry == UACPI_NULL)) {
+        ctx->status = UACPI_STATUS_OUT_OF_MEMORY;
+        return UACPI_FALSE;
+    }
+
+    uacpi_shareable_ref(node);
+    entry->node = node;
+    entry->hash = pnp_id_hash(id);
+    entry->next = PNP_ID_INDEX_END;
+    return UACPI_TRUE;
+}
+
+static uacpi_iteration_decision pnp_id_index_add_device(
+    void *opaque, uacpi_namespace_node *node, uacpi_u32 depth
+)
+{
+    struct pnp_id_index_build_ctx *ctx = opaque;
+    uacpi_id_string *hid = UACPI_NULL;
+    uacpi_pnp_id_list *cid = UACPI_NULL;
+    uacpi_iteration_decision decision = UACPI_ITERATION_DECISION_CONTINUE;
+    uacpi_u32 i;
+
+    UACPI_UNUSED(depth);
+
+    if (uacpi_eval_hid(node, &hid) == UACPI_STATUS_OK &&
+        !pnp_id_index_add(ctx, node, hid->value)) {
+        decision = UACPI_ITERATION_DECISION_BREAK;
+        goto out;
+    }
+
+    if (uacpi_eval_cid(node, &cid) == UACPI_STATUS_OK) {
+        for (i = 0; i < cid->num_ids; ++i) {
+            if (!pnp_id_index_add(ctx, node, cid->ids[i].value)) {
+                decision = UACPI_ITERATION_DECISION_BREAK;
+                goto out;
+            }
+        }
+    }
+
+out:
+    uacpi_free_id_string(hid);
+    uacpi_free_pnp_id_list(cid);
+    return decision;
+}
+
+static uacpi_status pnp_id_index_build(struct pnp_id_index **out_index)
+{
+    struct pnp_id_index_build_ctx ctx = { 0 };
+    struct pnp_id_index *index = UACPI_NULL;
+    struct pnp_id_index_entry *entry;
+    uacpi_u32 i, bucket, generation, num_entries;
+    uacpi_status ret;
+
+    generation = uacpi_atomic_load32(&pnp_id_index_generation);
+
+    ret = uacpi_namespace_do_for_each_child(
+        uacpi_namespace_root(), pnp_id_index_add_device, UACPI_NULL,
+        UACPI_OBJECT_DEVICE_BIT, UACPI_MAX_DEPTH_ANY, UACPI_SHOULD_LOCK_YES,
+        UACPI_PERMANENT_ONLY_YES, &ctx
+    );
+    if (uacpi_likely_success(ret))
+        ret = ctx.status;
+
+    num_entries = pnp_id_entry_array_size(&ctx.entries);
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
+    index = uacpi_kernel_alloc_zeroed(sizeof(*index));
+    if (uacpi_unlikely(index == UACPI_NULL)) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    index->generation = generation;
+    index->num_buckets = PNP_ID_INDEX_MIN_BUCKETS;
+    while (index->num_buckets < num_entries)
+        index->num_buckets *= 2;
+
+    index->buckets = uacpi_kernel_alloc(
+        sizeof(*index->buckets) * index->num_buckets
+    );
+    if (uacpi_unlikely(index->buckets == UACPI_NULL)) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    if (num_entries != 0) {
+        index->entries = uacpi_kernel_alloc(
+            sizeof(*index->entries) * num_entries
+        );
+        if (uacpi_unlikely(index->entries == UACPI_NULL)) {
+            ret = UACPI_STATUS_OUT_OF_MEMORY;
+            goto out;
+        }
+    }
+
+    for (i = 0; i < index->num_buckets; ++i)
+        index->buckets[i] = PNP_ID_INDEX_END;
+
+    // Insert backwards so that every bucket chain ends up in walk order
+    for (i = num_entries; i-- > 0;) {
+        entry = &index->entries[i];
+        *entry = *pnp_id_entry_array_at(&ctx.entries, i);
+
+        bucket = entry->hash & (index->num_buckets - 1);
+        entry->next = index->buckets[bucket];
+        index->buckets[bucket] = i;
+    }
+
+    // The index now owns all of the node references
+    index->num_entries = num_entries;
+    num_entries = 0;
+
+out:
+    for (i = 0; i < num_entries; ++i)
+        uacpi_namespace_node_unref(pnp_id_entry_array_at(&ctx.entries, i)->node);
+    pnp_id_entry_array_clear(&ctx.entries);
+
+    if (uacpi_unlikely_error(ret)) {
+        pnp_id_index_free(index);
+        return ret;
+    }
+
+    *out_index = index;
+    return ret;
+}
+
+struct pnp_id_candidate {
+    uacpi_namespace_node *node;
+    uacpi_u32 idx;
+};
+
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE(
+    pnp_id_candidate_array, struct pnp_id_candidate, 16
+)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+    pnp_id_candidate_array, struct pnp_id_candidate, static
+)
+
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE(node_array, uacpi_namespace_node*, 8)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+    node_array, uacpi_namespace_node*, static
+)
+
+/*
+ * Collect referenced candidates for any of the 'hids' sorted in walk order,
+ * with duplicates (e.g. both _HID and _CID matching) removed.
+ */
+static uacpi_status pnp_id_index_collect(
+    const uacpi_char *const *hids, struct pnp_id_candidate_array *out
+)
+{
+    struct pnp_id_index *index;
+    struct pnp_id_index_entry *entry;
+    struct pnp_id_candidate *cand, tmp;
+    uacpi_u32 i, j, hash, cur;
+    uacpi_size count;
+    uacpi_status ret;
+
+    ret = uacpi_acquire_native_mutex(pnp_id_index_mutex);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    index = pnp_id_index;
+    if (index == UACPI_NULL || index->generation !=
+        uacpi_atomic_load32(&pnp_id_index_generation)) {
+        pnp_id_index_free(index);
+        pnp_id_index = UACPI_NULL;
+
+        ret = pnp_id_index_build(&pnp_id_index);
+        if (uacpi_unlikely_error(ret))
+            goto out;
+
+        index = pnp_id_index;
+    }
+
+    for (i = 0; hids[i]; ++i) {
+        hash = pnp_id_hash(hids[i]);
+        cur = index->buckets[hash & (index->num_buckets - 1)];
+
+        for (; cur != PNP_ID_INDEX_END; cur = entry->next) {
+            entry = &index->entries[cur];
+            if (entry->hash != hash)
+                continue;
+
+            cand = pnp_id_candidate_array_alloc(out);
+            if (uacpi_unlikely(cand == UACPI_NULL)) {
+                ret = UACPI_STATUS_OUT_OF_MEMORY;
+                goto out;
+            }
+
+            uacpi_shareable_ref(entry->node);
+            cand->node = entry->node;
+            cand->idx = cur;
+        }
+    }
+
+out:
+    uacpi_release_native_mutex(pnp_id_index_mutex);
+
+    // Insertion sort, these lists are tiny for any realistic set of IDs
+    count = pnp_id_candidate_array_size(out);
+    for (i = 1; i < count; ++i) {
+        tmp = *pnp_id_candidate_array_at(out, i);
+
+        for (j = i; j > 0; --j) {
+            cand = pnp_id_candidate_array_at(out, j - 1);
+            if (cand->idx <= tmp.idx)
+                break;
+
+            *pnp_id_candidate_array_at(out, j) = *cand;
+        }
+
+        *pnp_id_candidate_array_at(out, j) = tmp;
+    }
+
+    return ret;
+}
+
+/*
+ * Returns the depth of 'node' relative to 'parent' the same way
+ * uacpi_namespace_for_each_child() would, or 0 if it's not a descendant of
+ * 'parent', or a descendant of any node in 'skipped'. Nodes are expected in
+ * walk order, so skipped subtrees that 'node' is not part of are dropped, as
+ * no later node can be a part of them either.
+ */
+static uacpi_u32 pnp_id_candidate_depth(
+    uacpi_namespace_node *parent, uacpi_namespace_node *node,
+    struct node_array *skipped
+)
+{
+    uacpi_namespace_node *cur, *skip;
+    uacpi_u32 depth = 0;
+    uacpi_bool below_skip;
+
+    if (uacpi_namespace_node_is_dangling(node))
+        return 0;
+
+    while (node_array_size(skipped) != 0) {
+        skip = *node_array_last(skipped);
+        below_skip = UACPI_FALSE;
+
+        for (cur = node->parent; cur != UACPI_NULL; cur = cur->parent) {
+            if (cur == skip) {
+                below_skip = UACPI_TRUE;
+                break;
+            }
+        }
+
+        if (below_skip)
+            return 0;
+
+        node_array_pop(skipped);
+    }
+
+    for (cur = node; cur != UACPI_NULL && cur != parent; cur = cur->parent)
+        depth++;
+
+    return cur == parent ? depth : 0;
+}
+
+static uacpi_status find_devices_indexed(
+    uacpi_namespace_node *parent, const uacpi_char *const *hids,
+    uacpi_iteration_callback cb, void *user
+)
+{
+    struct pnp_id_candidate_array cands = { 0 };
+    struct node_array skipped = { 0 };
+    uacpi_namespace_node *node, **skip_slot;
+    uacpi_iteration_decision decision;
+    uacpi_size i, count;
+    uacpi_u32 depth, flags;
+    uacpi_status ret;
+
+    ret = pnp_id_index_collect(hids, &cands);
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
+    count = pnp_id_candidate_array_size(&cands);
+
+    for (i = 0; i < count; ++i) {
+        node = pnp_id_candidate_array_at(&cands, i)->node;
+
+        // Duplicates are adjacent after sorting
+        if (i != 0 && pnp_id_candidate_array_at(&cands, i - 1)->node == node)
+            continue;
+
+        ret = uacpi_namespace_read_lock();
+        if (uacpi_unlikely_error(ret))
+            goto out;
+
+        depth = pnp_id_candidate_depth(parent, node, &skipped);
+        uacpi_namespace_read_unlock();
+
+        if (depth == 0 || !uacpi_device_matches_pnp_id(node, hids))
+            continue;
+
+        decision = UACPI_ITERATION_DECISION_NEXT_PEER;
+
+        ret = uacpi_eval_sta(node, &flags);
+        if (uacpi_likely_success(ret) &&
+            ((flags & ACPI_STA_RESULT_DEVICE_PRESENT) ||
+             (flags & ACPI_STA_RESULT_DEVICE_FUNCTIONING)))
+            decision = cb(user, node, depth);
+        ret = UACPI_STATUS_OK;
+
+        if (decision == UACPI_ITERATION_DECISION_BREAK)
+            break;
+        if (decision == UACPI_ITERATION_DECISION_CONTINUE)
+            continue;
+
+        // Same as the walk, matches within this subtree are not reported
+        skip_slot = node_array_alloc(&skipped);
+        if (uacpi_unlikely(skip_slot == UACPI_NULL)) {
+            ret = UACPI_STATUS_OUT_OF_MEMORY;
+            goto out;
+        }
+        *skip_slot = node;
+    }
+
+out:
+    count = pnp_id_candidate_array_size(&cands);
+    for (i = 0; i < count; ++i)
+        uacpi_namespace_node_unref(pnp_id_candidate_array_at(&cands, i)->node);
+
+    pnp_id_candidate_array_clear(&cands);
+    node_array_clear(&skipped);
+    return ret;
+}
+#endif
+
 uacpi_status uacpi_find_devices_at(
     uacpi_namespace_node *parent, const uacpi_char *const *hids,
     uacpi_iteration_callback cb, void *user
@@ -964,6 +1376,16 @@ uacpi_status uacpi_find_devices_at(
         .cb = cb,
     };
 
+#ifdef UACPI_PNP_ID_INDEX
+    /*
+     * _HID & _CID are not guaranteed to be evaluatable before _INI has been
+     * run, so only start relying on the index afterwards.
+     */
+    if (parent != UACPI_NULL && g_uacpi_rt_ctx.init_level >=
+        UACPI_INIT_LEVEL_NAMESPACE_INITIALIZED)
+        return find_devices_indexed(parent, hids, cb, user);
+#endif
+
     return uacpi_namespace_for_each_child(
         parent, find_one_device, UACPI_NULL, UACPI_OBJECT_DEVICE_BIT,
         UACPI_MAX_DEPTH_ANY, &ctx
@@ -1000,13 +1422,16 @@ uacpi_status uacpi_set_interrupt_model(uacpi_interrupt_model model)
     ret = uacpi_eval(uacpi_namespace_root(), "_PIC", &args, UACPI_NULL);
     uacpi_object_unref(arg);
 
+    // _PRT usually reports different routing depending on the model
+    uacpi_invalidate_pci_routing_cache();
+
     if (ret == UACPI_STATUS_NOT_FOUND)
         ret = UACPI_STATUS_OK;
 
     return ret;
 }
 
-uacpi_status uacpi_get_pci_routing_table(
+static uacpi_status eval_pci_routing_table(
     uacpi_namespace_node *parent, uacpi_pci_routing_table **out_table
 )
 {
@@ -1017,8 +1442,6 @@ uacpi_status uacpi_get_pci_routing_table(
     uacpi_pci_routing_table *table;
     uacpi_size size, i;
 
-    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
-
     obj = uacpi_namespace_node_get_object(parent);
     if (uacpi_unlikely(obj == UACPI_NULL || obj->type != UACPI_OBJECT_DEVICE))
         return UACPI_STATUS_INVALID_ARGUMENT;
@@ -1118,6 +1541,331 @@ out_bad_encoding:
     return UACPI_STATUS_AML_BAD_ENCODING;
 }
 
+// Entries are keyed by the device (slot) number & pin
+static uacpi_u32 pci_route_key(uacpi_u16 device, uacpi_u8 pin)
+{
+    return ((uacpi_u32)device << 8) | pin;
+}
+
+#ifdef UACPI_PCI_ROUTING_CACHE
+static uacpi_size pci_routing_table_size(uacpi_size num_entries)
+{
+    return sizeof(uacpi_pci_routing_table) +
+           num_entries * sizeof(uacpi_pci_routing_table_entry);
+}
+
+struct pci_route_key {
+    uacpi_u32 key;
+    uacpi_u32 idx;
+};
+
+/*
+ * A validated _PRT as returned by eval_pci_routing_table, along with an array
+ * of all of its entries sorted by device & pin for quick lookups.
+ */
+struct pci_routing_cache_entry {
+    struct pci_routing_cache_entry *next;
+    uacpi_namespace_node *bridge;
+    uacpi_pci_routing_table *table;
+    struct pci_route_key *keys;
+};
+
+static uacpi_handle pci_routing_mutex;
+static struct pci_routing_cache_entry *pci_routing_cache;
+
+/*
+ * The cache is flushed on first use whenever these don't match, which allows
+ * invalidating it without taking the mutex.
+ */
+static uacpi_u32 pci_routing_generation;
+static uacpi_u32 pci_routing_cache_generation;
+
+static void pci_routing_cache_entry_free(struct pci_routing_cache_entry *entry)
+{
+    if (entry->keys != UACPI_NULL) {
+        uacpi_free(
+            entry->keys, sizeof(*entry->keys) * entry->table->num_entries
+        );
+    }
+
+    uacpi_free_pci_routing_table(entry->table);
+    uacpi_namespace_node_unref(entry->bridge);
+    uacpi_free(entry, sizeof(*entry));
+}
+
+static void pci_routing_cache_flush(void)
+{
+    struct pci_routing_cache_entry *entry, *next;
+
+    for (entry = pci_routing_cache; entry; entry = next) {
+        next = entry->next;
+        pci_routing_cache_entry_free(entry);
+    }
+
+    pci_routing_cache = UACPI_NULL;
+}
+
+static uacpi_status pci_routing_cache_entry_create(
+    uacpi_namespace_node *bridge, struct pci_routing_cache_entry **out_entry
+)
+{
+    struct pci_routing_cache_entry *entry;
+    uacpi_pci_routing_table_entry *prt_entry;
+    struct pci_route_key key;
+    uacpi_size i, j;
+    uacpi_status ret;
+
+    entry = uacpi_kernel_alloc_zeroed(sizeof(*entry));
+    if (uacpi_unlikely(entry == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    ret = eval_pci_routing_table(bridge, &entry->table);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_free(entry, sizeof(*entry));
+        return ret;
+    }
+
+    uacpi_shareable_ref(bridge);
+    entry->bridge = bridge;
+
+    entry->keys = uacpi_kernel_alloc(
+        sizeof(*entry->keys) * entry->table->num_entries
+    );
+    if (uacpi_unlikely(entry->keys == UACPI_NULL)) {
+        pci_routing_cache_entry_free(entry);
+        return UACPI_STATUS_OUT_OF_MEMORY;
+    }
+
+    /*
+     * Insertion sort, _PRTs are at most 1024 entries and are usually already
+     * sorted by device. Equal keys keep their original order so that lookups
+     * find the same entry as a linear search would.
+     */
+    for (i = 0; i < entry->table->num_entries; ++i) {
+        prt_entry = &entry->table->entries[i];
+        key.key = pci_route_key(prt_entry->address >> 16, prt_entry->pin);
+        key.idx = i;
+
+        for (j = i; j > 0 && entry->keys[j - 1].key > key.key; --j)
+            entry->keys[j] = entry->keys[j - 1];
+
+        entry->keys[j] = key;
+    }
+
+    *out_entry = entry;
+    return UACPI_STATUS_OK;
+}
+
+// Must be called with pci_routing_mutex held
+static struct pci_routing_cache_entry *pci_routing_cache_find(
+    uacpi_namespace_node *bridge, uacpi_u32 generation
+)
+{
+    struct pci_routing_cache_entry *entry;
+
+    if (generation != pci_routing_cache_generation) {
+        pci_routing_cache_flush();
+        pci_routing_cache_generation = generation;
+    }
+
+    for (entry = pci_routing_cache; entry; entry = entry->next) {
+        if (entry->bridge == bridge)
+            return entry;
+    }
+
+    return UACPI_NULL;
+}
+
+/*
+ * Returns with pci_routing_mutex held on success. _PRT is evaluated without
+ * the mutex, so that it never nests with the namespace lock or any handlers
+ * the AML might invoke, and bridges don't wait on each other's evaluation.
+ * If another thread caches the same bridge in the meantime, its entry wins
+ * and ours is dropped.
+ */
+static uacpi_status pci_routing_cache_get(
+    uacpi_namespace_node *bridge, struct pci_routing_cache_entry **out_entry
+)
+{
+    struct pci_routing_cache_entry *entry, *new_entry;
+    uacpi_u32 generation;
+    uacpi_status ret;
+
+    for (;;) {
+        ret = uacpi_acquire_native_mutex(pci_routing_mutex);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        generation = uacpi_atomic_load32(&pci_routing_generation);
+        entry = pci_routing_cache_find(bridge, generation);
+        if (entry != UACPI_NULL) {
+            *out_entry = entry;
+            return UACPI_STATUS_OK;
+        }
+
+        uacpi_release_native_mutex(pci_routing_mutex);
+
+        ret = pci_routing_cache_entry_create(bridge, &new_entry);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        ret = uacpi_acquire_native_mutex(pci_routing_mutex);
+        if (uacpi_unlikely_error(ret)) {
+            pci_routing_cache_entry_free(new_entry);
+            return ret;
+        }
+
+        /*
+         * The cache was invalidated while _PRT was being evaluated, our
+         * result might already be stale so evaluate it again.
+         */
+        if (uacpi_atomic_load32(&pci_routing_generation) != generation) {
+            uacpi_release_native_mutex(pci_routing_mutex);
+            pci_routing_cache_entry_free(new_entry);
+            continue;
+        }
+
+        entry = pci_routing_cache_find(bridge, generation);
+        if (entry != UACPI_NULL) {
+            pci_routing_cache_entry_free(new_entry);
+            *out_entry = entry;
+            return UACPI_STATUS_OK;
+        }
+
+        new_entry->next = pci_routing_cache;
+        pci_routing_cache = new_entry;
+
+        *out_entry = new_entry;
+        return UACPI_STATUS_OK;
+    }
+}
+#endif
+
+uacpi_status uacpi_get_pci_routing_table(
+    uacpi_namespace_node *parent, uacpi_pci_routing_table **out_table
+)
+{
+#ifdef UACPI_PCI_ROUTING_CACHE
+    struct pci_routing_cache_entry *entry;
+    uacpi_pci_routing_table *table;
+    uacpi_size size;
+    uacpi_status ret;
+#endif
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+#ifdef UACPI_PCI_ROUTING_CACHE
+    ret = pci_routing_cache_get(parent, &entry);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    size = pci_routing_table_size(entry->table->num_entries);
+    table = uacpi_kernel_alloc(size);
+    if (uacpi_unlikely(table == UACPI_NULL)) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    uacpi_memcpy(table, entry->table, size);
+    *out_table = table;
+
+out:
+    uacpi_release_native_mutex(pci_routing_mutex);
+    return ret;
+#else
+    return eval_pci_routing_table(parent, out_table);
+#endif
+}
+
+#ifdef UACPI_PCI_ROUTING_CACHE
+static uacpi_status find_pci_route(
+    uacpi_namespace_node *bridge, uacpi_u32 key,
+    uacpi_pci_routing_table_entry *out_entry
+)
+{
+    struct pci_routing_cache_entry *entry;
+    uacpi_size lo, hi, mid;
+    uacpi_status ret;
+
+    ret = pci_routing_cache_get(bridge, &entry);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    // Find the first key that is not less than the one we're looking for
+    lo = 0;
+    hi = entry->table->num_entries;
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+
+        if (entry->keys[mid].key < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo == entry->table->num_entries || entry->keys[lo].key != key) {
+        ret = UACPI_STATUS_NOT_FOUND;
+        goto out;
+    }
+
+    *out_entry = entry->table->entries[entry->keys[lo].idx];
+
+out:
+    uacpi_release_native_mutex(pci_routing_mutex);
+    return ret;
+}
+#else
+static uacpi_status find_pci_route(
+    uacpi_namespace_node *bridge, uacpi_u32 key,
+    uacpi_pci_routing_table_entry *out_entry
+)
+{
+    uacpi_pci_routing_table *table;
+    uacpi_pci_routing_table_entry *entry;
+    uacpi_status ret;
+    uacpi_size i;
+
+    ret = eval_pci_routing_table(bridge, &table);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = UACPI_STATUS_NOT_FOUND;
+
+    for (i = 0; i < table->num_entries; ++i) {
+        entry = &table->entries[i];
+
+        if (pci_route_key(entry->address >> 16, entry->pin) == key) {
+            *out_entry = *entry;
+            ret = UACPI_STATUS_OK;
+            break;
+        }
+    }
+
+    uacpi_free_pci_routing_table(table);
+    return ret;
+}
+#endif
+
+uacpi_status uacpi_get_pci_route(
+    uacpi_namespace_node *bridge, uacpi_u16 device, uacpi_u8 pin,
+    uacpi_pci_routing_table_entry *out_entry
+)
+{
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+    if (uacpi_unlikely(out_entry == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    return find_pci_route(bridge, pci_route_key(device, pin), out_entry);
+}
+
+void uacpi_invalidate_pci_routing_cache(void)
+{
+#ifdef UACPI_PCI_ROUTING_CACHE
+    uacpi_atomic_inc32(&pci_routing_generation);
+#endif
+}
+
 void uacpi_free_pci_routing_table(uacpi_pci_routing_table *table)
 {
     if (table == UACPI_NULL)
@@ -1137,3 +1885,52 @@ void uacpi_free_dynamic_string(const uacpi_char *str)
 
     uacpi_free((void*)str, uacpi_strlen(str) + 1);
 }
+
+uacpi_status uacpi_initialize_utilities(void)
+{
+#ifdef UACPI_PNP_ID_INDEX
+    pnp_id_index_mutex = uacpi_kernel_create_mutex();
+    if (uacpi_unlikely(pnp_id_index_mutex == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+#endif
+
+#ifdef UACPI_PCI_ROUTING_CACHE
+    pci_routing_mutex = uacpi_kernel_create_mutex();
+    if (uacpi_unlikely(pci_routing_mutex == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+#endif
+
+    return UACPI_STATUS_OK;
+}
+
+void uacpi_deinitialize_utilities(void)
+{
+#ifdef UACPI_PNP_ID_INDEX
+    pnp_id_index_free(pnp_id_index);
+    pnp_id_index = UACPI_NULL;
+
+    if (pnp_id_index_mutex != UACPI_NULL)
+        uacpi_kernel_free_mutex(pnp_id_index_mutex);
+    pnp_id_index_mutex = UACPI_NULL;
+    pnp_id_index_generation = 0;
+#endif
+
+#ifdef UACPI_PCI_ROUTING_CACHE
+    pci_routing_cache_flush();
+
+    if (pci_routing_mutex != UACPI_NULL)
+        uacpi_kernel_free_mutex(pci_routing_mutex);
+    pci_routing_mutex = UACPI_NULL;
+    pci_routing_generation = 0;
+    pci_routing_cache_generation = 0;
+#endif
+}
+
+void uacpi_utilities_invalidate_caches(void)
+{
+#ifdef UACPI_PNP_ID_INDEX
+    uacpi_atomic_inc32(&pnp_id_index_generation);
+#endif
+
+    uacpi_invalidate_pci_routing_cache();
+}
@@ -10,6 +10,8 @@
 #include <unordered_set>
 #include <cstring>
 #include <cinttypes>
+#include <memory>
+#include <algorithm>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -144,9 +146,59 @@ virt_to_phys_and_refcount;
 static std::unordered_map<uacpi_phys_addr, std::unordered_set<mapping>>
 phys_to_virt;
 
+/*
+ * Emulated physical memory, allocated lazily one page at a time. Every mapping
+ * is a private copy of the pages it covers: it's filled from here when created
+ * and written back when destroyed, so data written via a mapping survives it
+ * being unmapped and mapped again later (e.g. by a different region window).
+ */
+static constexpr uacpi_phys_addr phys_page_size = 4096;
+
+static std::unordered_map<uacpi_phys_addr, std::unique_ptr<uint8_t[]>>
+phys_pages;
+
+static void phys_copy(
+    uacpi_phys_addr addr, uint8_t *virt, size_t size, bool to_phys
+)
+{
+    while (size) {
+        auto page_addr = addr & ~(phys_page_size - 1);
+        auto offset = addr - page_addr;
+        auto count = std::min<size_t>(size, phys_page_size - offset);
+        auto it = phys_pages.find(page_addr);
+
+        if (to_phys) {
+            if (it == phys_pages.end()) {
+                it = phys_pages.emplace(
+                    page_addr, std::make_unique<uint8_t[]>(phys_page_size)
+                ).first;
+            }
+
+            std::memcpy(it->second.get() + offset, virt, count);
+        } else if (it != phys_pages.end()) {
+            std::memcpy(virt, it->second.get() + offset, count);
+        }
+
+        addr += count;
+        virt += count;
+        size -= count;
+    }
+}
+
+static void phys_write_back_all()
+{
+    for (auto& [phys, mappings] : phys_to_virt) {
+        for (auto& m : mappings)
+            phys_copy(phys, static_cast<uint8_t*>(m.virt), m.size, true);
+    }
+}
+
 void* uacpi_kernel_map(uacpi_phys_addr addr, uacpi_size size)
 {
     if (!g_expect_virtual_addresses) {
+        // Make sure the new mapping sees writes done via the live ones
+        phys_write_back_all();
+
         auto it = phys_to_virt.find(addr);
         if (it != phys_to_virt.end()) {
             auto mapping_it = it->second.find({ nullptr, size });
@@ -161,6 +213,7 @@ void* uacpi_kernel_map(uacpi_phys_addr addr, uacpi_size size)
         }
 
         void *virt = std::calloc(size, 1);
+        phys_copy(addr, static_cast<uint8_t*>(virt), size, false);
         mapping m = { virt, size };
 
         virt_to_phys_and_refcount[virt] = { addr, 1 };
@@ -188,6 +241,10 @@ void uacpi_kernel_unmap(void* addr, uacpi_size size)
         return;
     }
 
+    phys_copy(
+        it->second.first, static_cast<uint8_t*>(addr), size, true
+    );
+
     phys_it->second.erase(mapping_it);
     if (phys_it->second.empty())
         phys_to_virt.erase(it->second.first);
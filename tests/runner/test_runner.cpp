@@ -382,6 +382,215 @@ static void test_object_api()
     uacpi_object_unref(objects[0]);
 }
 
+static void test_eval_batch()
+{
+    static const char *device_paths[] = {
+        "\\_SB.DEV5", "\\_SB.DEV0", "\\_SB.DEV1", "\\_SB.DEV6",
+        "\\_SB.DEV2", "\\_SB.DEV3",
+    };
+    constexpr size_t num_devices = sizeof(device_paths) / sizeof(*device_paths);
+
+    uacpi_namespace_node *nodes[num_devices];
+    uacpi_status statuses[num_devices];
+    uacpi_object *objs[num_devices];
+    uacpi_status st;
+
+    for (size_t i = 0; i < num_devices; ++i) {
+        st = uacpi_namespace_node_find(UACPI_NULL, device_paths[i], &nodes[i]);
+        ensure_ok_status(st);
+    }
+
+    auto check_results = [&](const uacpi_u64 (&expected)[num_devices]) {
+        for (size_t i = 0; i < num_devices; ++i) {
+            uacpi_u64 value;
+
+            if (expected[i] == ~0ull) {
+                if (statuses[i] != UACPI_STATUS_NOT_FOUND ||
+                    objs[i] != UACPI_NULL)
+                    throw std::runtime_error("expected batch lookup to fail");
+                continue;
+            }
+
+            ensure_ok_status(statuses[i]);
+
+            st = uacpi_object_get_integer(objs[i], &value);
+            ensure_ok_status(st);
+            uacpi_object_unref(objs[i]);
+
+            if (value != expected[i])
+                throw std::runtime_error("invalid batch evaluation result");
+        }
+    };
+
+    st = uacpi_eval_batch(nodes, num_devices, "STAT", UACPI_NULL,
+                          statuses, objs);
+    ensure_ok_status(st);
+    // DEV6 comes after DEV1 and must observe its side effects
+    check_results({ 0, 0x0F, 1, 1, 0x0B, ~0ull });
+
+    st = uacpi_eval_batch(nodes, num_devices, "STAT", UACPI_NULL,
+                          statuses, objs);
+    ensure_ok_status(st);
+    // DEV5 must not see a stale memoized result after DEV1 modified CNT
+    check_results({ 1, 0x0F, 2, 2, 0x0B, ~0ull });
+
+    // Results are optional
+    st = uacpi_eval_batch(nodes, num_devices, "STAT", UACPI_NULL,
+                          statuses, UACPI_NULL);
+    ensure_ok_status(st);
+
+    // Multi-segment relative paths & arguments
+    uacpi_object *arg = uacpi_object_create_integer(5);
+    uacpi_object_array args = { &arg, 1 };
+
+    st = uacpi_eval_batch(nodes, num_devices, "^DEV4.TEST", &args,
+                          statuses, objs);
+    uacpi_object_unref(arg);
+    ensure_ok_status(st);
+    check_results({ 6, 6, 6, 6, 6, 6 });
+}
+
+static void test_find_devices()
+{
+    struct find_ctx {
+        std::string found;
+        uacpi_iteration_decision (*decide)(std::string_view name);
+    };
+
+    auto find = [](
+        uacpi_namespace_node *parent, std::vector<const char*> hids,
+        uacpi_iteration_decision (*decide)(std::string_view) = nullptr
+    ) {
+        find_ctx ctx { {}, decide };
+        hids.push_back(UACPI_NULL);
+
+        auto st = uacpi_find_devices_at(
+            parent, hids.data(),
+            [](void *opaque, uacpi_namespace_node *node, uacpi_u32 depth) {
+                auto& ctx = *reinterpret_cast<find_ctx*>(opaque);
+                auto name = uacpi_namespace_node_name(node);
+                std::string_view name_view(name.text, sizeof(name.text));
+
+                if (!ctx.found.empty())
+                    ctx.found += ",";
+                ctx.found += name_view;
+                ctx.found += ":" + std::to_string(depth);
+
+                if (ctx.decide != nullptr)
+                    return ctx.decide(name_view);
+                return UACPI_ITERATION_DECISION_CONTINUE;
+            }, &ctx
+        );
+        ensure_ok_status(st);
+        return ctx.found;
+    };
+
+    auto expect = [](const std::string& found, std::string_view expected) {
+        if (found != expected) {
+            throw std::runtime_error(
+                "unexpected devices found: " + found + ", expected " +
+                std::string(expected)
+            );
+        }
+    };
+
+    uacpi_namespace_node *root = uacpi_namespace_root();
+    uacpi_namespace_node *pci0;
+
+    auto st = uacpi_namespace_node_find(UACPI_NULL, "\\_SB.PCI0", &pci0);
+    ensure_ok_status(st);
+
+    // Twice to make sure repeated lookups are consistent
+    for (int i = 0; i < 2; ++i) {
+        expect(find(root, { "ACPI0001" }),
+               "DEVA:3,DEVB:3,DEVF:3,DEVG:2");
+    }
+
+    expect(find(pci0, { "PNP0C0F", "ACPI0002" }), "DEVB:1");
+    expect(find(pci0, { "PNP0A03" }), "");
+    expect(find(root, { "PNP0A03" }), "PCI0:2");
+    expect(find(root, { "NONE0000" }), "");
+
+    expect(find(root, { "ACPI0002", "ACPI0001" }, [](std::string_view name) {
+        return name == "DEVE" ? UACPI_ITERATION_DECISION_NEXT_PEER :
+                                UACPI_ITERATION_DECISION_CONTINUE;
+    }), "DEVA:3,DEVB:3,DEVE:2,DEVG:2");
+
+    expect(find(root, { "ACPI0001" }, [](std::string_view) {
+        return UACPI_ITERATION_DECISION_BREAK;
+    }), "DEVA:3");
+}
+
+static void test_pci_routing()
+{
+    uacpi_namespace_node *pci0, *lnka;
+    uacpi_pci_routing_table *table;
+    uacpi_status st;
+
+    st = uacpi_namespace_node_find(UACPI_NULL, "\\_SB.PCI0", &pci0);
+    ensure_ok_status(st);
+    st = uacpi_namespace_node_find(UACPI_NULL, "\\_SB.LNKA", &lnka);
+    ensure_ok_status(st);
+
+    auto expect_route = [&](
+        uacpi_u16 device, uacpi_u8 pin, uacpi_namespace_node *source,
+        uacpi_u32 index
+    ) {
+        uacpi_pci_routing_table_entry entry;
+
+        auto st = uacpi_get_pci_route(pci0, device, pin, &entry);
+        ensure_ok_status(st);
+
+        if (entry.address != ((uacpi_u32(device) << 16) | 0xFFFF) ||
+            entry.pin != pin || entry.source != source ||
+            entry.index != index)
+            throw std::runtime_error("unexpected PCI route");
+    };
+
+    auto expect_no_route = [&](uacpi_u16 device, uacpi_u8 pin) {
+        uacpi_pci_routing_table_entry entry;
+
+        auto st = uacpi_get_pci_route(pci0, device, pin, &entry);
+        if (st != UACPI_STATUS_NOT_FOUND)
+            throw std::runtime_error("expected PCI route lookup to fail");
+    };
+
+    // Repeated to hit the cache as well, if enabled
+    for (int i = 0; i < 2; ++i) {
+        expect_route(1, 0, lnka, 0);
+        expect_route(1, 1, UACPI_NULL, 11);
+        expect_route(2, 0, lnka, 0);
+        expect_route(2, 1, lnka, 0);
+        expect_no_route(2, 2);
+        expect_no_route(3, 0);
+    }
+
+    // The full table is returned in the original order
+    st = uacpi_get_pci_routing_table(pci0, &table);
+    ensure_ok_status(st);
+    auto guard = ScopeGuard(
+        [&table] { uacpi_free_pci_routing_table(table); }
+    );
+
+    if (table->num_entries != 4 || table->entries[0].address != 0x0002FFFF ||
+        table->entries[0].pin != 1 || table->entries[3].index != 11)
+        throw std::runtime_error("unexpected PCI routing table");
+
+    st = uacpi_set_interrupt_model(UACPI_INTERRUPT_MODEL_IOAPIC);
+    ensure_ok_status(st);
+
+    expect_route(1, 0, UACPI_NULL, 20);
+    expect_route(1, 1, UACPI_NULL, 21);
+    expect_route(2, 0, UACPI_NULL, 18);
+    expect_route(2, 1, UACPI_NULL, 19);
+
+    st = uacpi_execute(UACPI_NULL, "SWAP", UACPI_NULL);
+    ensure_ok_status(st);
+
+    expect_route(1, 0, UACPI_NULL, 30);
+    expect_no_route(1, 1);
+}
+
 static void run_test(
     std::string_view dsdt_path, const std::vector<std::string>& ssdt_paths,
     uacpi_object_type expected_type, std::string_view expected_value,
@@ -480,6 +689,19 @@ static void run_test(
     if (st != UACPI_STATUS_NOT_FOUND)
         throw std::runtime_error("couldn't uninstall interface");
 
+    // The osi test expects this one to not be reported as supported
+    st = uacpi_install_interface(
+        "AnotherTestString", UACPI_INTERFACE_KIND_FEATURE
+    );
+    ensure_ok_status(st);
+
+    st = uacpi_uninstall_interface("AnotherTestString");
+    ensure_ok_status(st);
+
+    st = uacpi_uninstall_interface("AnotherTestString");
+    if (st != UACPI_STATUS_NOT_FOUND)
+        throw std::runtime_error("couldn't uninstall dynamic interface");
+
     st = uacpi_enable_host_interface(UACPI_HOST_INTERFACE_3_0_THERMAL_MODEL);
     ensure_ok_status(st);
 
@@ -545,6 +767,21 @@ static void run_test(
         return;
     }
 
+    if (expected_value == "check-eval-batch-works") {
+        test_eval_batch();
+        return;
+    }
+
+    if (expected_value == "check-find-devices-works") {
+        test_find_devices();
+        return;
+    }
+
+    if (expected_value == "check-pci-routing-works") {
+        test_pci_routing();
+        return;
+    }
+
     uacpi_object* ret = UACPI_NULL;
     auto guard = ScopeGuard(
         [&ret] { uacpi_object_unref(ret); }